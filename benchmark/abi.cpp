@@ -0,0 +1,113 @@
+#include <eosio/chain/abi_serializer.hpp>
+#include <fc/io/json.hpp>
+
+#include <benchmark.hpp>
+
+using namespace eosio::chain;
+
+namespace eosio::benchmark {
+
+namespace {
+
+// nested structs and arrays, four levels deep, with the field types contracts commonly use
+const char* deep_abi = R"=====(
+{
+   "version": "eosio::abi/1.1",
+   "structs": [
+      {
+         "name": "leaf",
+         "base": "",
+         "fields": [
+            {"name": "id", "type": "uint64"},
+            {"name": "owner", "type": "name"},
+            {"name": "quantity", "type": "asset"},
+            {"name": "memo", "type": "string"},
+            {"name": "flags", "type": "uint8[]"}
+         ]
+      },
+      {
+         "name": "branch",
+         "base": "",
+         "fields": [
+            {"name": "id", "type": "uint32"},
+            {"name": "hash", "type": "checksum256"},
+            {"name": "leaves", "type": "leaf[]"},
+            {"name": "tags", "type": "string[]"}
+         ]
+      },
+      {
+         "name": "tree",
+         "base": "",
+         "fields": [
+            {"name": "version", "type": "uint16"},
+            {"name": "created", "type": "time_point_sec"},
+            {"name": "branches", "type": "branch[]"},
+            {"name": "extra", "type": "bytes?"}
+         ]
+      },
+      {
+         "name": "forest",
+         "base": "",
+         "fields": [
+            {"name": "trees", "type": "tree[]"}
+         ]
+      }
+   ],
+   "actions": [],
+   "tables": []
+}
+)=====";
+
+fc::variant make_forest(uint32_t num_trees, uint32_t branches_per_tree, uint32_t leaves_per_branch) {
+   fc::variants trees;
+   for (uint32_t t = 0; t < num_trees; ++t) {
+      fc::variants branches;
+      for (uint32_t b = 0; b < branches_per_tree; ++b) {
+         fc::variants leaves;
+         for (uint32_t l = 0; l < leaves_per_branch; ++l) {
+            leaves.emplace_back(fc::mutable_variant_object()
+               ("id", uint64_t(t) << 32 | b << 16 | l)
+               ("owner", "alice")
+               ("quantity", "1.0000 SYS")
+               ("memo", "benchmark leaf " + std::to_string(l))
+               ("flags", fc::variants{1, 2, 3, 4}));
+         }
+         branches.emplace_back(fc::mutable_variant_object()
+            ("id", b)
+            ("hash", fc::sha256::hash(std::to_string(b)))
+            ("leaves", std::move(leaves))
+            ("tags", fc::variants{"one", "two", "three"}));
+      }
+      trees.emplace_back(fc::mutable_variant_object()
+         ("version", 1)
+         ("created", "2020-01-01T00:00:00")
+         ("branches", std::move(branches))
+         ("extra", "00112233"));
+   }
+   return fc::mutable_variant_object()("trees", std::move(trees));
+}
+
+} // anonymous namespace
+
+void abi_benchmarking() {
+   auto yield = abi_serializer::create_yield_function(fc::microseconds::maximum());
+   abi_serializer abis(fc::json::from_string(deep_abi).as<abi_def>(), yield);
+
+   struct forest_size {
+      uint32_t trees;
+      uint32_t branches;
+      uint32_t leaves;
+   };
+   for (const auto& s : {forest_size{1, 1, 1}, forest_size{2, 4, 8}, forest_size{4, 16, 32}}) {
+      bytes binary = abis.variant_to_binary("forest", make_forest(s.trees, s.branches, s.leaves), yield);
+      uint32_t num_leaves = s.trees * s.branches * s.leaves;
+
+      auto binary_to_variant = [&]() {
+         abis.binary_to_variant("forest", binary, yield);
+      };
+      benchmarking("binary_to_variant (" + std::to_string(num_leaves) + " leaves, " + std::to_string(binary.size()) + " bytes)",
+                   binary_to_variant, num_leaves);
+   }
+}
+
+} // benchmark
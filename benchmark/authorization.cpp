@@ -0,0 +1,72 @@
+#include <eosio/chain/authorization_manager.hpp>
+#include <eosio/testing/tester.hpp>
+
+#include <benchmark.hpp>
+
+using namespace eosio::chain;
+using namespace eosio::testing;
+
+// Benchmark authorization_manager::check_authorization against permissions
+// stored in chain state.
+//
+// To run a benchmarking session, in the build directory, type
+//    benchmark/benchmark -f authorization
+
+namespace eosio::benchmark {
+
+void authorization_benchmarking() {
+   // prevent logging from interwined with output benchmark results
+   fc::logger::get(DEFAULT_LOGGER).set_log_level(fc::log_level::off);
+
+   tester chain;
+   chain.create_accounts({"alice"_n, "multisig"_n, "delegated"_n});
+
+   // multisig@active is 2 of 3 keys
+   vector<key_weight> keys{{tester::get_public_key("multisig"_n, "k1"), 1},
+                           {tester::get_public_key("multisig"_n, "k2"), 1},
+                           {tester::get_public_key("multisig"_n, "k3"), 1}};
+   std::sort(keys.begin(), keys.end());
+   chain.set_authority("multisig"_n, config::active_name, authority(2, keys));
+
+   // delegated@active is satisfied by alice@active
+   chain.set_authority("delegated"_n, config::active_name, authority(permission_level{"alice"_n, config::active_name}));
+   chain.produce_block();
+
+   const auto& auth_manager = chain.control->get_authorization_manager();
+
+   auto make_actions = [](account_name actor, uint32_t num_actions) {
+      vector<action> actions;
+      for (uint32_t i = 0; i < num_actions; ++i) {
+         actions.emplace_back(vector<permission_level>{{actor, config::active_name}}, config::system_account_name,
+                              "reqauth"_n, fc::raw::pack(actor));
+      }
+      return actions;
+   };
+
+   flat_set<public_key_type> alice_keys{tester::get_public_key("alice"_n, "active")};
+   flat_set<public_key_type> multisig_keys{keys[0].key, keys[1].key};
+
+   for (uint32_t num_actions : {1u, 16u}) {
+      const std::string suffix = " (" + std::to_string(num_actions) + " actions)";
+
+      auto single_key_actions = make_actions("alice"_n, num_actions);
+      auto single_key = [&]() {
+         auth_manager.check_authorization(single_key_actions, alice_keys);
+      };
+      benchmarking("check_authorization single key" + suffix, single_key, num_actions);
+
+      auto multisig_actions = make_actions("multisig"_n, num_actions);
+      auto multisig = [&]() {
+         auth_manager.check_authorization(multisig_actions, multisig_keys);
+      };
+      benchmarking("check_authorization 2 of 3 keys" + suffix, multisig, num_actions);
+
+      auto delegated_actions = make_actions("delegated"_n, num_actions);
+      auto delegated = [&]() {
+         auth_manager.check_authorization(delegated_actions, alice_keys);
+      };
+      benchmarking("check_authorization delegated" + suffix, delegated, num_actions);
+   }
+}
+
+} // benchmark
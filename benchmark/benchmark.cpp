@@ -1,10 +1,48 @@
+#include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
 #include <locale>
+#include <new>
 
 #include <benchmark.hpp>
 
+// count every heap allocation made through operator new so each benchmark can report
+// the number of allocations per run. Array, nothrow and sized variants end up here.
+namespace {
+std::atomic<uint64_t> allocations{0};
+
+void* counted_alloc(std::size_t size) {
+   allocations.fetch_add(1, std::memory_order_relaxed);
+   if (void* p = std::malloc(size ? size : 1))
+      return p;
+   throw std::bad_alloc();
+}
+
+void* counted_aligned_alloc(std::size_t size, std::align_val_t al) {
+   allocations.fetch_add(1, std::memory_order_relaxed);
+   auto align = static_cast<std::size_t>(al);
+   // aligned_alloc requires the size to be a multiple of the alignment
+   if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align))
+      return p;
+   throw std::bad_alloc();
+}
+} // anonymous namespace
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void* operator new(std::size_t size, std::align_val_t al) { return counted_aligned_alloc(size, al); }
+void* operator new[](std::size_t size, std::align_val_t al) { return counted_aligned_alloc(size, al); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
 namespace eosio::benchmark {
 
 // update this map when a new feature is supported
@@ -15,7 +53,15 @@ std::map<std::string, std::function<void()>> features {
    { "key", key_benchmarking },
    { "hash", hash_benchmarking },
    { "blake2", blake2_benchmarking },
-   { "bls", bls_benchmarking }
+   { "bls", bls_benchmarking },
+   { "merkle", merkle_benchmarking },
+   { "block_serialization", block_serialization_benchmarking },
+   { "abi", abi_benchmarking },
+   { "authorization", authorization_benchmarking },
+   { "push_block", push_block_benchmarking },
+#ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
+   { "oc_memory", oc_memory_benchmarking },
+#endif
 };
 
 // values to control cout format
@@ -23,6 +69,9 @@ constexpr auto name_width = 40;
 constexpr auto runs_width = 5;
 constexpr auto time_width = 12;
 constexpr auto ns_width = 2;
+constexpr auto allocs_width = 12;
+constexpr auto throughput_width = 16;
+constexpr auto per_sec_width = 2;
 
 uint32_t num_runs = 1;
 
@@ -40,10 +89,14 @@ void print_header() {
       << std::setw(time_width + ns_width) << std::right << "average"
       << std::setw(time_width + ns_width) << "minimum"
       << std::setw(time_width + ns_width) << "maximum"
+      << std::setw(allocs_width) << "allocs"
+      << std::setw(throughput_width + per_sec_width) << "throughput"
       << std::endl << std::endl;
 }
 
-void print_results(std::string name, uint32_t runs, uint64_t total, uint64_t min, uint64_t max) {
+void print_results(std::string name, uint32_t runs, uint64_t total, uint64_t min, uint64_t max, uint64_t allocs, uint64_t items_per_run) {
+   // items per second from the average run time
+   const double throughput = total ? double(items_per_run) * runs * 1e9 / total : 0;
    std::cout.imbue(std::locale(""));
    std::cout
       << std::setw(name_width) << std::left << name
@@ -54,6 +107,8 @@ void print_results(std::string name, uint32_t runs, uint64_t total, uint64_t min
       << std::setw(time_width) << total/runs << std::setw(ns_width) << " ns"
       << std::setw(time_width) << min << std::setw(ns_width) << " ns"
       << std::setw(time_width) << max << std::setw(ns_width) << " ns"
+      << std::setw(allocs_width) << allocs/runs
+      << std::setw(throughput_width) << throughput << std::setw(per_sec_width) << "/s"
       << std::endl;
 }
 
@@ -63,15 +118,25 @@ bytes to_bytes(const std::string& source) {
    return output;
 };
 
-void benchmarking(const std::string& name, const std::function<void()>& func) {
+void benchmarking(const std::string& name, const std::function<void()>& func, uint64_t items_per_run) {
+   benchmarking(name, {}, func, items_per_run);
+}
+
+void benchmarking(const std::string& name, const std::function<void()>& setup, const std::function<void()>& func, uint64_t items_per_run) {
    uint64_t total{0};
    uint64_t min{std::numeric_limits<uint64_t>::max()};
    uint64_t max{0};
+   uint64_t allocs{0};
 
    for (auto i = 0U; i < num_runs; ++i) {
+      if (setup)
+         setup();
+
+      auto start_allocs = allocations.load(std::memory_order_relaxed);
       auto start_time = std::chrono::high_resolution_clock::now();
       func();
       auto end_time = std::chrono::high_resolution_clock::now();
+      allocs += allocations.load(std::memory_order_relaxed) - start_allocs;
 
       uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
       total += duration;
@@ -79,7 +144,7 @@ void benchmarking(const std::string& name, const std::function<void()>& func) {
       max = std::max(max, duration);
    }
 
-   print_results(name, num_runs, total, min, max);
+   print_results(name, num_runs, total, min, max, allocs, items_per_run);
 }
 
 } // benchmark
@@ -21,7 +21,20 @@ void key_benchmarking();
 void hash_benchmarking();
 void blake2_benchmarking();
 void bls_benchmarking();
+void merkle_benchmarking();
+void block_serialization_benchmarking();
+void abi_benchmarking();
+void authorization_benchmarking();
+void push_block_benchmarking();
+#ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
+void oc_memory_benchmarking();
+#endif
 
-void benchmarking(const std::string& name, const std::function<void()>& func); 
+// items_per_run is the number of items (hashes, transactions, blocks...) one call of func processes,
+// used to report throughput in items per second
+void benchmarking(const std::string& name, const std::function<void()>& func, uint64_t items_per_run = 1);
+
+// setup is called before every run of func and is not included in the timing nor the allocation count
+void benchmarking(const std::string& name, const std::function<void()>& setup, const std::function<void()>& func, uint64_t items_per_run);
 
 } // benchmark
@@ -0,0 +1,63 @@
+#include <eosio/chain/block.hpp>
+#include <eosio/chain/config.hpp>
+#include <fc/io/raw.hpp>
+
+#include <benchmark.hpp>
+
+using namespace eosio::chain;
+
+namespace eosio::benchmark {
+
+namespace {
+
+// a block of num_trxs signed transactions, each with one reqauth action and a context free nonce action,
+// similar to what a busy producer puts on the wire
+signed_block make_block(uint32_t num_trxs, const fc::crypto::private_key& key, const chain_id_type& chain_id) {
+   signed_block block;
+   block.timestamp = block_timestamp_type(fc::time_point::now());
+   block.producer  = "producer"_n;
+   block.previous  = fc::sha256::hash(std::string("previous"));
+   block.transactions.reserve(num_trxs);
+
+   for (uint32_t i = 0; i < num_trxs; ++i) {
+      signed_transaction trx;
+      trx.expiration       = fc::time_point_sec(fc::time_point::now()) + 3600;
+      trx.ref_block_num    = 1;
+      trx.ref_block_prefix = i;
+      trx.actions.emplace_back(vector<permission_level>{{"alice"_n, config::active_name}},
+                               config::system_account_name, "reqauth"_n, fc::raw::pack("alice"_n));
+      trx.context_free_actions.emplace_back(vector<permission_level>{}, config::null_account_name, "nonce"_n,
+                                            fc::raw::pack(std::to_string(i)));
+      trx.sign(key, chain_id);
+      block.transactions.emplace_back(packed_transaction(std::move(trx)));
+   }
+   block.producer_signature = key.sign(block.calculate_id());
+   return block;
+}
+
+} // anonymous namespace
+
+void block_serialization_benchmarking() {
+   auto key = fc::crypto::private_key::regenerate<fc::ecc::private_key_shim>(fc::sha256::hash(std::string("block_serialization")));
+   auto chain_id = chain_id_type::empty_chain_id();
+
+   for (uint32_t num_trxs : {1u, 100u, 1000u}) {
+      signed_block block = make_block(num_trxs, key, chain_id);
+      bytes packed = fc::raw::pack(block);
+      std::string suffix = " (" + std::to_string(num_trxs) + " trxs, " + std::to_string(packed.size()) + " bytes)";
+
+      auto pack_block = [&]() {
+         fc::raw::pack(block);
+      };
+      benchmarking("pack signed_block" + suffix, pack_block, num_trxs);
+
+      auto unpack_block = [&]() {
+         fc::datastream<const char*> ds(packed.data(), packed.size());
+         signed_block unpacked;
+         fc::raw::unpack(ds, unpacked);
+      };
+      benchmarking("unpack signed_block" + suffix, unpack_block, num_trxs);
+   }
+}
+
+} // benchmark
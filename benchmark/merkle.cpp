@@ -0,0 +1,24 @@
+#include <eosio/chain/merkle.hpp>
+
+#include <benchmark.hpp>
+
+using namespace eosio::chain;
+
+namespace eosio::benchmark {
+
+void merkle_benchmarking() {
+   for (uint32_t num_digests : {64u, 1024u, 16384u}) {
+      deque<digest_type> ids;
+      for (uint32_t i = 0; i < num_digests; ++i) {
+         ids.emplace_back(fc::sha256::hash(i));
+      }
+
+      // merkle() takes its argument by value, the copy is part of what every caller pays
+      auto merkle_root = [&]() {
+         merkle(ids);
+      };
+      benchmarking("merkle (" + std::to_string(num_digests) + " digests)", merkle_root, num_digests);
+   }
+}
+
+} // benchmark
@@ -0,0 +1,46 @@
+#ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
+
+#include <eosio/chain/webassembly/eos-vm-oc/memory.hpp>
+#include <eosio/chain/wasm_eosio_constraints.hpp>
+
+#include <cstring>
+
+#include <benchmark.hpp>
+
+using namespace eosio::chain;
+
+namespace eosio::benchmark {
+
+// compares resetting EOS VM OC linear memory between executions by memset of the module's starting
+// memory, as done before every execution previously, against punching out only the pages used
+void oc_memory_benchmarking() {
+   constexpr uint64_t page_size = wasm_constraints::wasm_page_size;
+   eosvmoc::memory mem(wasm_constraints::maximum_linear_memory/page_size);
+   uint8_t* const base = mem.full_page_memory_base();
+
+   // dirty every 4K page of the first used_pages of linear memory, like an action writing to its memory
+   auto touch = [&](uint64_t used_pages) {
+      return [&, used_pages]() {
+         for (uint64_t offset = 0; offset < used_pages * page_size; offset += 4096)
+            base[offset] = 1;
+      };
+   };
+
+   for (uint64_t starting_pages : {16u, 528u}) {
+      for (uint64_t used_pages : {uint64_t{1}, starting_pages}) {
+         const std::string pages = " (" + std::to_string(used_pages) + "/" + std::to_string(starting_pages) + " pages)";
+
+         benchmarking("oc memory memset" + pages, touch(used_pages), [&]() {
+            memset(base, 0, starting_pages * page_size);
+         }, 1);
+
+         benchmarking("oc memory punch hole" + pages, touch(used_pages), [&]() {
+            mem.reset_sliced_memory(used_pages);
+         }, 1);
+      }
+   }
+}
+
+} // benchmark
+
+#endif
@@ -0,0 +1,57 @@
+#include <eosio/testing/tester.hpp>
+
+#include <benchmark.hpp>
+
+using namespace eosio::chain;
+using namespace eosio::testing;
+
+// Benchmark controller::push_block by replaying a synthetic block set into a fresh chain.
+//
+// To run a benchmarking session, in the build directory, type
+//    benchmark/benchmark -f push_block -r 20
+// Every run starts a new chain, a small number of runs is usually enough.
+
+namespace eosio::benchmark {
+
+void push_block_benchmarking() {
+   // prevent logging from interwined with output benchmark results
+   fc::logger::get(DEFAULT_LOGGER).set_log_level(fc::log_level::off);
+
+   constexpr uint32_t num_blocks = 10;
+   constexpr uint32_t trxs_per_block = 200;
+   constexpr uint32_t billed_cpu_time_us = 100;
+
+   // produce the block set once, the replaying chain starts from the same default genesis
+   tester chain;
+   vector<account_name> accounts{"alice"_n, "bob"_n, "carol"_n, "dave"_n};
+   chain.create_accounts(accounts);
+   chain.produce_block();
+
+   for (uint32_t b = 0; b < num_blocks; ++b) {
+      for (uint32_t t = 0; t < trxs_per_block; ++t) {
+         chain.push_dummy(accounts[t % accounts.size()], std::to_string(b * trxs_per_block + t), billed_cpu_time_us);
+      }
+      chain.produce_block();
+   }
+
+   vector<signed_block_ptr> blocks;
+   for (uint32_t n = 2; n <= chain.control->head_block_num(); ++n) {
+      blocks.emplace_back(chain.control->fetch_block_by_number(n));
+   }
+
+   std::unique_ptr<tester> replay;
+   auto new_chain = [&]() {
+      replay.reset();
+      replay = std::make_unique<tester>(setup_policy::none);
+   };
+   auto push_blocks = [&]() {
+      for (const auto& b : blocks) {
+         replay->push_block(b);
+      }
+   };
+   benchmarking("push_block (" + std::to_string(blocks.size()) + " blocks, " +
+                std::to_string(num_blocks * trxs_per_block) + " dummy trxs)",
+                new_chain, push_blocks, blocks.size());
+}
+
+} // benchmark
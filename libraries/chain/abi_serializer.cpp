@@ -6,6 +6,9 @@
 #include <fc/io/varint.hpp>
 #include <fc/time.hpp>
 
+#include <deque>
+#include <limits>
+
 namespace eosio { namespace chain {
 
    const size_t abi_serializer::max_recursion_depth;
@@ -71,6 +74,131 @@ namespace eosio { namespace chain {
       );
    }
 
+   namespace impl {
+      /**
+       * An ABI compiled for binary_to_variant: every type name reachable from the ABI is resolved once, through
+       * typedefs and suffixes, into a node that refers to the nodes of its element and field types by index.
+       * Decoding with the plan produces the same variant as _binary_to_variant but does no type name lookups.
+       * Binary it cannot decode is reported by throwing decode_failed, without a path; the caller then decodes again
+       * with _binary_to_variant for the error message. Serialization deadline and recursion depth exceptions of the
+       * yield function, and anything else that is not a decoding error, propagate as they are.
+       */
+      struct binary_to_variant_plan {
+         static constexpr uint32_t no_base = std::numeric_limits<uint32_t>::max();
+
+         struct decode_failed {};
+
+         enum class node_kind : uint8_t { unknown, built_in, array, optional, variant, struct_type };
+
+         struct node {
+            node_kind                                      kind = node_kind::unknown;
+            bool                                           is_array = false;    // built_in
+            bool                                           is_optional = false; // built_in
+            uint32_t                                       element = 0;         // node of array/optional, struct of struct_type
+            abi_serializer::unpack_function                unpack;              // built_in
+            vector<pair<string, uint32_t>>                 alternatives;        // variant type names and their nodes
+         };
+
+         struct field {
+            string   name;
+            uint32_t type = 0;
+            bool     extension = false;
+         };
+
+         struct struct_plan {
+            bool          known = false;
+            uint32_t      base = no_base;
+            vector<field> fields;
+         };
+
+         vector<node>                              nodes;
+         vector<struct_plan>                       structs;
+         map<string, uint32_t, std::less<>>        node_by_type;
+         map<string, uint32_t, std::less<>>        struct_by_type;
+
+         // depth is tracked exactly as abi_traverse_context::enter_scope() would for the same input
+         fc::variant decode( uint32_t n, fc::datastream<const char*>& stream, size_t depth, const abi_serializer::yield_function_t& yield )const {
+            yield( ++depth );
+            const node& nd = nodes[n];
+            switch( nd.kind ) {
+               case node_kind::built_in:
+                  try {
+                     return nd.unpack( stream, nd.is_array, nd.is_optional, yield );
+                  } catch( const abi_serialization_deadline_exception& ) {
+                     throw;
+                  } catch( const abi_recursion_depth_exception& ) {
+                     throw;
+                  } catch( const fc::exception& ) {
+                     throw decode_failed{};
+                  }
+               case node_kind::array: {
+                  fc::unsigned_int size;
+                  read( stream, size );
+                  vector<fc::variant> vars;
+                  vars.reserve( std::min<size_t>( size.value, stream.remaining() ) );
+                  for( decltype(size.value) i = 0; i < size; ++i )
+                     vars.emplace_back( decode( nd.element, stream, depth, yield ) );
+                  return fc::variant( std::move(vars) );
+               }
+               case node_kind::optional: {
+                  char flag;
+                  read( stream, flag );
+                  return flag ? decode( nd.element, stream, depth, yield ) : fc::variant();
+               }
+               case node_kind::variant: {
+                  fc::unsigned_int select;
+                  read( stream, select );
+                  if( select.value >= nd.alternatives.size() )
+                     throw decode_failed{};
+                  const auto& alternative = nd.alternatives[select.value];
+                  vector<fc::variant> vars;
+                  vars.reserve( 2 );
+                  vars.emplace_back( alternative.first );
+                  vars.emplace_back( decode( alternative.second, stream, depth, yield ) );
+                  return fc::variant( std::move(vars) );
+               }
+               case node_kind::struct_type: {
+                  fc::mutable_variant_object mvo;
+                  decode_struct( nd.element, stream, depth, mvo, yield );
+                  if( mvo.size() == 0 )
+                     throw decode_failed{};
+                  return fc::variant( std::move(mvo) );
+               }
+               case node_kind::unknown:
+                  break;
+            }
+            throw decode_failed{};
+         }
+
+         void decode_struct( uint32_t n, fc::datastream<const char*>& stream, size_t depth, fc::mutable_variant_object& mvo,
+                             const abi_serializer::yield_function_t& yield )const {
+            yield( ++depth );
+            const struct_plan& st = structs[n];
+            if( !st.known )
+               throw decode_failed{};
+            if( st.base != no_base )
+               decode_struct( st.base, stream, depth, mvo, yield );
+            for( const field& f : st.fields ) {
+               if( !stream.remaining() ) {
+                  if( !f.extension )
+                     throw decode_failed{};
+                  continue;
+               }
+               mvo( f.name, decode( f.type, stream, depth, yield ) );
+            }
+         }
+
+         template<typename T>
+         static void read( fc::datastream<const char*>& stream, T& v ) {
+            try {
+               fc::raw::unpack( stream, v );
+            } catch( const fc::exception& ) {
+               throw decode_failed{};
+            }
+         }
+      };
+   }
+
    abi_serializer::abi_serializer( abi_def abi, const yield_function_t& yield ) {
       configure_built_in_types();
       set_abi(std::move(abi), yield);
@@ -84,6 +212,8 @@ namespace eosio { namespace chain {
    void abi_serializer::add_specialized_unpack_pack( const string& name,
                                                      std::pair<abi_serializer::unpack_function, abi_serializer::pack_function> unpack_pack ) {
       built_in_types[name] = std::move( unpack_pack );
+      if( decode_plan )
+         compile_binary_to_variant_plan();
    }
 
    void abi_serializer::configure_built_in_types() {
@@ -187,6 +317,107 @@ namespace eosio { namespace chain {
       EOS_ASSERT( action_results.size() == action_results_size, duplicate_abi_action_results_def_exception, "duplicate action results definition detected" );
 
       validate(ctx);
+
+      compile_binary_to_variant_plan();
+   }
+
+   // Mirrors the type resolution of _binary_to_variant. Types are resolved from a work list rather than recursively,
+   // an ABI may nest structs arbitrarily deep.
+   void abi_serializer::compile_binary_to_variant_plan() {
+      using node_kind = impl::binary_to_variant_plan::node_kind;
+
+      auto plan = std::make_shared<impl::binary_to_variant_plan>();
+      std::deque<std::pair<uint32_t, std::string_view>> pending_nodes;
+      std::deque<std::pair<uint32_t, std::string_view>> pending_structs;
+
+      auto node_for = [&]( const std::string_view& type ) -> uint32_t {
+         auto itr = plan->node_by_type.find( type );
+         if( itr == plan->node_by_type.end() ) {
+            itr = plan->node_by_type.emplace( string(type), plan->nodes.size() ).first;
+            plan->nodes.emplace_back();
+            pending_nodes.emplace_back( itr->second, itr->first );
+         }
+         return itr->second;
+      };
+      auto struct_for = [&]( const std::string_view& type ) -> uint32_t {
+         auto itr = plan->struct_by_type.find( type );
+         if( itr == plan->struct_by_type.end() ) {
+            itr = plan->struct_by_type.emplace( string(type), plan->structs.size() ).first;
+            plan->structs.emplace_back();
+            pending_structs.emplace_back( itr->second, itr->first );
+         }
+         return itr->second;
+      };
+
+      for( const auto& a : actions )
+         node_for( a.second );
+      for( const auto& t : tables )
+         node_for( t.second );
+      for( const auto& r : action_results )
+         node_for( r.second );
+      for( const auto& st : structs )
+         node_for( st.first );
+      for( const auto& v : variants )
+         node_for( v.first );
+      for( const auto& td : typedefs )
+         node_for( td.first );
+
+      while( !pending_nodes.empty() || !pending_structs.empty() ) {
+         if( !pending_nodes.empty() ) {
+            const auto [n, type] = pending_nodes.front();
+            pending_nodes.pop_front();
+
+            auto rtype = resolve_type(type);
+            auto ftype = fundamental_type(rtype);
+            auto btype = built_in_types.find(ftype);
+            if( btype != built_in_types.end() ) {
+               auto& nd = plan->nodes[n];
+               nd.kind = node_kind::built_in;
+               nd.is_array = is_array(rtype);
+               nd.is_optional = is_optional(rtype);
+               nd.unpack = btype->second.first;
+            } else if( is_array(rtype) || is_optional(rtype) ) {
+               const uint32_t element = node_for( ftype );
+               plan->nodes[n].kind = is_array(rtype) ? node_kind::array : node_kind::optional;
+               plan->nodes[n].element = element;
+            } else if( auto v_itr = variants.find(rtype); v_itr != variants.end() ) {
+               vector<pair<string, uint32_t>> alternatives;
+               alternatives.reserve( v_itr->second.types.size() );
+               for( const auto& alternative : v_itr->second.types )
+                  alternatives.emplace_back( alternative, node_for( alternative ) );
+               plan->nodes[n].kind = node_kind::variant;
+               plan->nodes[n].alternatives = std::move( alternatives );
+            } else if( structs.find(rtype) != structs.end() ) {
+               const uint32_t st = struct_for( rtype );
+               plan->nodes[n].kind = node_kind::struct_type;
+               plan->nodes[n].element = st;
+            }
+         } else {
+            const auto [n, type] = pending_structs.front();
+            pending_structs.pop_front();
+
+            auto s_itr = structs.find(type);
+            if( s_itr == structs.end() )
+               continue;
+            const auto& st = s_itr->second;
+            const uint32_t base = st.base != type_name() ? struct_for( resolve_type(st.base) )
+                                                         : impl::binary_to_variant_plan::no_base;
+            vector<impl::binary_to_variant_plan::field> fields;
+            fields.reserve( st.fields.size() );
+            for( const auto& field : st.fields ) {
+               const bool extension = ends_with(field.type, "$");
+               fields.push_back( { .name = field.name,
+                                   .type = node_for( resolve_type( extension ? _remove_bin_extension(field.type) : field.type ) ),
+                                   .extension = extension } );
+            }
+            auto& sp = plan->structs[n];
+            sp.known = true;
+            sp.base = base;
+            sp.fields = std::move( fields );
+         }
+      }
+
+      decode_plan = std::move( plan );
    }
 
    void abi_serializer::set_abi(const abi_def& abi, const fc::microseconds& max_serialization_time) {
@@ -462,7 +693,28 @@ namespace eosio { namespace chain {
    {
       auto h = ctx.enter_scope();
       fc::datastream<const char*> ds( binary.data(), binary.size() );
-      return _binary_to_variant(type, ds, ctx);
+      return _binary_to_variant_with_plan(type, ds, ctx);
+   }
+
+   fc::variant abi_serializer::_binary_to_variant_with_plan( const std::string_view& type, fc::datastream<const char*>& binary,
+                                                            impl::binary_to_variant_context& ctx )const
+   {
+      // logging trims bytes fields, only the type name driven path does that
+      if( decode_plan && !ctx.is_logging() ) {
+         const auto& plan = *decode_plan;
+         auto itr = plan.node_by_type.find(type);
+         if( itr != plan.node_by_type.end() ) {
+            fc::datastream<const char*> ds = binary;
+            try {
+               auto v = plan.decode( itr->second, ds, ctx.get_recursion_depth(), ctx.get_yield_function_ref() );
+               binary = ds;
+               return v;
+            } catch( const impl::binary_to_variant_plan::decode_failed& ) {
+               // decode again below, which reports the error with the path of the field that failed
+            }
+         }
+      }
+      return _binary_to_variant(type, binary, ctx);
    }
 
    fc::variant abi_serializer::binary_to_variant( const std::string_view& type, const bytes& binary, const yield_function_t& yield, bool short_path )const {
@@ -480,13 +732,13 @@ namespace eosio { namespace chain {
    fc::variant abi_serializer::binary_to_variant( const std::string_view& type, fc::datastream<const char*>& binary, const yield_function_t& yield, bool short_path )const {
       impl::binary_to_variant_context ctx(*this, yield, fc::microseconds{}, type);
       ctx.short_path = short_path;
-      return _binary_to_variant(type, binary, ctx);
+      return _binary_to_variant_with_plan(type, binary, ctx);
    }
 
    fc::variant abi_serializer::binary_to_variant( const std::string_view& type, fc::datastream<const char*>& binary, const fc::microseconds& max_action_data_serialization_time, bool short_path )const {
       impl::binary_to_variant_context ctx(*this, create_depth_yield_function(), max_action_data_serialization_time, type);
       ctx.short_path = short_path;
-      return _binary_to_variant(type, binary, ctx);
+      return _binary_to_variant_with_plan(type, binary, ctx);
    }
 
    void abi_serializer::_variant_to_binary( const std::string_view& type, const fc::variant& var, fc::datastream<char *>& ds, impl::variant_to_binary_context& ctx )const
@@ -926,4 +1178,21 @@ namespace eosio { namespace chain {
       }
    }
 
+   void versioned_abi_cache::invalidate(const account_name& account) {
+      const size_t i = slot_index(account);
+      std::lock_guard g(stripes[i % stripe_count]);
+      // the slot may be filled for account by a serializer built before this invalidate
+      ++generations[i];
+      if (slots[i] && slots[i]->account == account)
+         slots[i].reset();
+   }
+
+   void versioned_abi_cache::clear() {
+      for (size_t i = 0; i < slot_count; ++i) {
+         std::lock_guard g(stripes[i % stripe_count]);
+         ++generations[i];
+         slots[i].reset();
+      }
+   }
+
 } }
@@ -48,11 +48,13 @@ apply_context::apply_context(controller& con, transaction_context& trx_ctx, uint
 ,recurse_depth(depth)
 ,first_receiver_action_ordinal(action_ordinal)
 ,action_ordinal(action_ordinal)
-,idx64(*this)
-,idx128(*this)
-,idx256(*this)
-,idx_double(*this)
-,idx_long_double(*this)
+,itr_caches(acquire_iterator_caches())
+,idx64(*this, itr_caches->idx64)
+,idx128(*this, itr_caches->idx128)
+,idx256(*this, itr_caches->idx256)
+,idx_double(*this, itr_caches->idx_double)
+,idx_long_double(*this, itr_caches->idx_long_double)
+,keyval_cache(itr_caches->keyval)
 {
    action_trace& trace = trx_ctx.get_action_trace(action_ordinal);
    act = &trace.act;
@@ -60,6 +62,37 @@ apply_context::apply_context(controller& con, transaction_context& trx_ctx, uint
    context_free = trace.context_free;
 }
 
+apply_context::~apply_context() {
+   release_iterator_caches( std::move(itr_caches) );
+}
+
+// inline actions are applied while their creator's apply_context is alive, so this is a stack per thread
+std::vector<std::unique_ptr<apply_context::iterator_caches>>& apply_context::iterator_caches_pool() {
+   thread_local std::vector<std::unique_ptr<iterator_caches>> pool = [] {
+      std::vector<std::unique_ptr<iterator_caches>> p;
+      p.reserve( max_pooled_iterator_caches ); // release never allocates
+      return p;
+   }();
+   return pool;
+}
+
+std::unique_ptr<apply_context::iterator_caches> apply_context::acquire_iterator_caches() {
+   auto& pool = iterator_caches_pool();
+   if( pool.empty() )
+      return std::make_unique<iterator_caches>();
+   auto caches = std::move(pool.back());
+   pool.pop_back();
+   return caches;
+}
+
+void apply_context::release_iterator_caches( std::unique_ptr<iterator_caches> caches ) {
+   auto& pool = iterator_caches_pool();
+   if( !caches || pool.size() >= max_pooled_iterator_caches )
+      return;
+   caches->reset();
+   pool.push_back( std::move(caches) );
+}
+
 void apply_context::exec_one()
 {
    auto start = fc::time_point::now();
@@ -670,11 +703,17 @@ uint32_t apply_context::schedule_action( action&& act_to_schedule, account_name
 }
 
 const table_id_object* apply_context::find_table( name code, name scope, name table ) {
-   return db.find<table_id_object, by_code_scope_table>(boost::make_tuple(code, scope, table));
+   auto& cache = trx_context.table_cache;
+   if( cache.size() >= transaction_context::max_cached_tables )
+      cache.clear();
+   auto [itr, inserted] = cache.try_emplace( transaction_context::table_key{code, scope, table}, nullptr );
+   if( inserted )
+      itr->second = db.find<table_id_object, by_code_scope_table>(boost::make_tuple(code, scope, table));
+   return itr->second;
 }
 
 const table_id_object& apply_context::find_or_create_table( name code, name scope, name table, const account_name &payer ) {
-   const auto* existing_tid =  db.find<table_id_object, by_code_scope_table>(boost::make_tuple(code, scope, table));
+   const auto* existing_tid = find_table(code, scope, table);
    if (existing_tid != nullptr) {
       return *existing_tid;
    }
@@ -690,7 +729,7 @@ const table_id_object& apply_context::find_or_create_table( name code, name scop
 
    update_db_usage(payer, config::billable_size_v<table_id_object>);
 
-   return db.create<table_id_object>([&](table_id_object &t_id){
+   const auto& tid = db.create<table_id_object>([&](table_id_object &t_id){
       t_id.code = code;
       t_id.scope = scope;
       t_id.table = table;
@@ -700,6 +739,8 @@ const table_id_object& apply_context::find_or_create_table( name code, name scop
          dm_logger->on_create_table(t_id);
       }
    });
+   trx_context.table_cache[transaction_context::table_key{code, scope, table}] = &tid;
+   return tid;
 }
 
 void apply_context::remove_table( const table_id_object& tid ) {
@@ -718,6 +759,7 @@ void apply_context::remove_table( const table_id_object& tid ) {
       dm_logger->on_remove_table(tid);
    }
 
+   trx_context.table_cache.erase(transaction_context::table_key{tid.code, tid.scope, tid.table});
    db.remove(tid);
 }
 
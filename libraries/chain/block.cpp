@@ -61,4 +61,8 @@ namespace eosio { namespace chain {
 
    }
 
+   std::shared_ptr<const bytes> signed_block::packed_block()const {
+      return packed_cache.get_or_pack( [this]() { return fc::raw::pack( *this ); } );
+   }
+
 } } /// namespace eosio::chain
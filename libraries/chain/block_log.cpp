@@ -7,6 +7,7 @@
 #include <fc/bitutil.hpp>
 #include <fc/io/raw.hpp>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 
 #if defined(__BYTE_ORDER__)
@@ -467,7 +468,8 @@ namespace eosio { namespace chain {
       struct block_log_impl {
          inline static uint32_t  default_initial_version = block_log::max_supported_version;
 
-         std::mutex       mtx;
+         // exclusive for append/reset/flush and anything that moves the file positions, shared for positional reads
+         std::shared_mutex mtx;
          struct signed_block_with_id {
             signed_block_ptr ptr;
             block_id_type id;
@@ -593,22 +595,51 @@ namespace eosio { namespace chain {
             FC_LOG_AND_RETHROW()
          }
 
+         // uses positional reads only, may be called concurrently by holders of a shared lock on mtx
          uint64_t get_block_pos(uint32_t block_num) final {
             if (!(head && block_num <= block_header::num_from_id(head->id) &&
                   block_num >= working_block_file_first_block_num()))
                return block_log::npos;
-            index_file.seek(sizeof(uint64_t) * (block_num - index_first_block_num()));
             uint64_t pos;
-            index_file.read((char*)&pos, sizeof(pos));
+            index_file.read_at((char*)&pos, sizeof(pos), sizeof(uint64_t) * (block_num - index_first_block_num()));
             return pos;
          }
 
+         /// Read the serialized block of block_num (without its trailing position) into buf using positional reads,
+         /// only its first max_size bytes when smaller.
+         /// @return false if block_num is not in the working block file
+         bool read_block_data(uint32_t block_num, std::vector<char>& buf,
+                              uint64_t max_size = std::numeric_limits<uint64_t>::max()) {
+            const uint64_t pos = get_block_pos(block_num);
+            if (pos == block_log::npos)
+               return false;
+
+            uint64_t end_pos;
+            if (block_num < block_header::num_from_id(head->id)) {
+               end_pos = get_block_pos(block_num + 1) - sizeof(uint64_t);
+            } else {
+               end_pos = block_file.filesize() - sizeof(uint64_t);
+               if (preamble.is_currently_pruned())
+                  end_pos -= sizeof(uint32_t);
+            }
+            EOS_ASSERT(end_pos > pos, block_log_exception,
+                       "Invalid block log entry for block ${num} at position ${pos}, end position ${end}",
+                       ("num", block_num)("pos", pos)("end", end_pos));
+
+            buf.resize(std::min(end_pos - pos, max_size));
+            block_file.read_at(buf.data(), buf.size(), pos);
+            return true;
+         }
+
          signed_block_ptr read_block_by_num(uint32_t block_num) final {
             try {
-               uint64_t pos = get_block_pos(block_num);
-               if (pos != block_log::npos) {
-                  block_file.seek(pos);
-                  return read_block(block_file, block_num);
+               std::vector<char> buf;
+               if (read_block_data(block_num, buf)) {
+                  fc::datastream<const char*> ds(buf.data(), buf.size());
+                  auto block = read_block(ds, block_num);
+                  if (ds.remaining() == 0) // keep the serialized block for relay to syncing peers and state history
+                     block->set_packed_block(std::make_shared<const bytes>(std::move(buf)));
+                  return block;
                }
                return retry_read_block_by_num(block_num);
             }
@@ -617,12 +648,19 @@ namespace eosio { namespace chain {
 
          std::optional<signed_block_header> read_block_header_by_num(uint32_t block_num) final {
             try {
-               uint64_t pos = get_block_pos(block_num);
-               if (pos != block_log::npos) {
-                  block_file.seek(pos);
-                  return read_block_header(block_file, block_num);
+               // a header usually fits in the prefix, only one with a large producer schedule or extensions does not
+               constexpr uint64_t header_read_size = 1024;
+               std::vector<char> buf;
+               if (!read_block_data(block_num, buf, header_read_size))
+                  return retry_read_block_header_by_num(block_num);
+               try {
+                  return read_block_header(fc::datastream<const char*>(buf.data(), buf.size()), block_num);
+               } catch (const fc::out_of_range_exception&) {
+                  if (buf.size() < header_read_size) // the whole block was read
+                     throw;
                }
-               return retry_read_block_header_by_num(block_num);
+               read_block_data(block_num, buf);
+               return read_block_header(fc::datastream<const char*>(buf.data(), buf.size()), block_num);
             }
             FC_LOG_AND_RETHROW()
          }
@@ -733,7 +771,7 @@ namespace eosio { namespace chain {
 
          void reset(const genesis_state& gs, const signed_block_ptr& first_block) override {
             this->reset(1, gs, default_initial_version);
-            this->append(first_block, first_block->calculate_id(), fc::raw::pack(*first_block));
+            this->append(first_block, first_block->calculate_id(), *first_block->packed_block());
          }
 
          void reset(const chain_id_type& chain_id, uint32_t first_block_num) override {
@@ -948,6 +986,7 @@ namespace eosio { namespace chain {
       struct partitioned_block_log final : basic_block_log {
          block_log_catalog catalog;
          const size_t      stride;
+         std::mutex        catalog_read_mtx; // catalog reads seek shared streams, serialize concurrent readers
 
          partitioned_block_log(const std::filesystem::path& log_dir, const partitioned_blocklog_config& config) : stride(config.stride) {
             catalog.open(log_dir, config.retained_dir, config.archive_dir, "blocks");
@@ -1026,6 +1065,7 @@ namespace eosio { namespace chain {
          }
 
          signed_block_ptr retry_read_block_by_num(uint32_t block_num) final {
+            std::lock_guard g(catalog_read_mtx);
             auto ds = catalog.ro_stream_for_block(block_num);
             if (ds)
                return read_block(*ds, block_num);
@@ -1033,6 +1073,7 @@ namespace eosio { namespace chain {
          }
 
          std::optional<signed_block_header> retry_read_block_header_by_num(uint32_t block_num) final {
+            std::lock_guard g(catalog_read_mtx);
             auto ds = catalog.ro_stream_for_block(block_num);
             if (ds)
                return read_block_header(*ds, block_num);
@@ -1194,14 +1235,14 @@ namespace eosio { namespace chain {
 
    void     block_log::set_initial_version(uint32_t ver) { detail::block_log_impl::default_initial_version = ver; }
    uint32_t block_log::version() const {
-      std::lock_guard g(my->mtx);
+      std::shared_lock g(my->mtx);
       return my->version();
    }
 
    void block_log::append(const signed_block_ptr& b, const block_id_type& id) {
-      std::vector<char> packed_block = fc::raw::pack(*b);
+      std::shared_ptr<const bytes> packed_block = b->packed_block();
       std::lock_guard g(my->mtx);
-      my->append(b, id, packed_block);
+      my->append(b, id, *packed_block);
    }
 
    void block_log::append(const signed_block_ptr& b, const block_id_type& id, const std::vector<char>& packed_block) {
@@ -1226,12 +1267,12 @@ namespace eosio { namespace chain {
    }
 
    signed_block_ptr block_log::read_block_by_num(uint32_t block_num) const {
-      std::lock_guard g(my->mtx);
+      std::shared_lock g(my->mtx);
       return my->read_block_by_num(block_num);
    }
 
    std::optional<signed_block_header> block_log::read_block_header_by_num(uint32_t block_num) const {
-      std::lock_guard g(my->mtx);
+      std::shared_lock g(my->mtx);
       return my->read_block_header_by_num(block_num);
    }
 
@@ -1243,7 +1284,7 @@ namespace eosio { namespace chain {
    }
 
    uint64_t block_log::get_block_pos(uint32_t block_num) const {
-      std::lock_guard g(my->mtx);
+      std::shared_lock g(my->mtx);
       return my->get_block_pos(block_num);
    }
 
@@ -1253,17 +1294,17 @@ namespace eosio { namespace chain {
    }
 
    signed_block_ptr block_log::head() const {
-      std::lock_guard g(my->mtx);
+      std::shared_lock g(my->mtx);
       return my->head ? my->head->ptr : signed_block_ptr{};
    }
 
    std::optional<block_id_type> block_log::head_id() const {
-      std::lock_guard g(my->mtx);
+      std::shared_lock g(my->mtx);
       return my->head ? my->head->id : std::optional<block_id_type>{};
    }
 
    uint32_t block_log::first_block_num() const {
-      std::lock_guard g(my->mtx);
+      std::shared_lock g(my->mtx);
       return my->first_block_num();
    }
 
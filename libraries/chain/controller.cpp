@@ -1,4 +1,5 @@
 #include <eosio/chain/controller.hpp>
+#include <eosio/chain/abi_serializer.hpp>
 #include <eosio/chain/transaction_context.hpp>
 
 #include <eosio/chain/block_log.hpp>
@@ -35,8 +36,10 @@
 #include <fc/variant_object.hpp>
 #include <bls12-381/bls12-381.hpp>
 
+#include <deque>
 #include <new>
 #include <shared_mutex>
+#include <unordered_map>
 #include <utility>
 
 namespace eosio { namespace chain {
@@ -67,6 +70,28 @@ using contract_database_index_set = index_set<
    index_long_double_index
 >;
 
+/**
+ * Rows of a chunk of the contract_tables section decoded on a worker thread. Rows of chainbase objects without shared
+ * members are pre-built outside of the database, the others are kept in their snapshot form. The rows are inserted in
+ * snapshot order on the main thread.
+ */
+template<typename IndexSet>
+struct snapshot_contract_tables_chunk;
+
+template<typename... Indices>
+struct snapshot_contract_tables_chunk<index_set<Indices...>> {
+   template<typename T>
+   using row_t = typename detail::snapshot_row_traits<T>::snapshot_type;
+
+   static constexpr size_t index_count = sizeof...(Indices);
+
+   std::vector<table_id_object>                                             tables;
+   std::vector<unsigned_int>                                                sizes; ///< index_count row counts per table
+   std::tuple<std::vector<row_t<typename Indices::value_type>>...>          rows;
+};
+
+using contract_tables_chunk = snapshot_contract_tables_chunk<contract_database_index_set>;
+
 class maybe_session {
    public:
       maybe_session() = default;
@@ -241,6 +266,7 @@ struct controller_impl {
    fork_database                   fork_db;
    resource_limits_manager         resource_limits;
    subjective_billing              subjective_bill;
+   versioned_abi_cache             abi_cache;
    authorization_manager           authorization;
    protocol_feature_manager        protocol_features;
    controller::config              conf;
@@ -442,10 +468,11 @@ struct controller_impl {
       auto branch = fork_db.fetch_branch( fork_head->id, fork_head->dpos_irreversible_blocknum );
       try {
 
-         std::vector<std::future<std::vector<char>>> v;
+         std::vector<std::future<std::shared_ptr<const bytes>>> v;
          v.reserve( branch.size() );
          for( auto bitr = branch.rbegin(); bitr != branch.rend(); ++bitr ) {
-            v.emplace_back( post_async_task( thread_pool.get_executor(), [b=(*bitr)->block]() { return fc::raw::pack(*b); } ) );
+            // shares the packed block with p2p relay and state history, usually already packed when received
+            v.emplace_back( post_async_task( thread_pool.get_executor(), [b=(*bitr)->block]() { return b->packed_block(); } ) );
          }
          auto it = v.begin();
 
@@ -459,8 +486,10 @@ struct controller_impl {
 
             // blog.append could fail due to failures like running out of space.
             // Do it before commit so that in case it throws, DB can be rolled back.
-            blog.append( (*bitr)->block, (*bitr)->id, it->get() );
+            blog.append( (*bitr)->block, (*bitr)->id, *it->get() );
             ++it;
+            // logged and already relayed, do not keep a second copy of the block alive with the block_state
+            (*bitr)->block->release_packed_block();
 
             db.commit( (*bitr)->block_num );
             root_id = (*bitr)->id;
@@ -509,6 +538,31 @@ struct controller_impl {
       initialize_database(genesis);
    }
 
+   // number of blocks read from the block log and prepared on the thread pool ahead of the block being replayed
+   static constexpr uint32_t replay_read_ahead_blocks = 64;
+
+   struct replay_read_ahead_block {
+      signed_block_ptr                                             block;
+      // signature recovery started for the packed transactions of block, only with force-all-checks
+      std::unordered_map<transaction_id_type, recover_keys_future> recovered_trxs;
+   };
+
+   // Called from thread pool: unpack a block from the block log and start recovering its transaction signatures
+   replay_read_ahead_block read_ahead_block_for_replay( uint32_t block_num ) {
+      replay_read_ahead_block result{ .block = blog.read_block_by_num( block_num ) };
+      if( result.block && conf.force_all_checks ) {
+         for( const auto& receipt : result.block->transactions ) {
+            if( std::holds_alternative<packed_transaction>(receipt.trx) ) {
+               const auto& pt = std::get<packed_transaction>(receipt.trx);
+               packed_transaction_ptr ptrx( result.block, &pt ); // alias signed_block_ptr
+               result.recovered_trxs.emplace( pt.id(), transaction_metadata::start_recover_keys(
+                     std::move( ptrx ), thread_pool.get_executor(), chain_id, fc::microseconds::maximum(), transaction_metadata::trx_type::input ) );
+            }
+         }
+      }
+      return result;
+   }
+
    void replay(std::function<bool()> check_shutdown) {
       auto blog_head = blog.head();
       if( !fork_db.root() ) {
@@ -526,12 +580,42 @@ struct controller_impl {
       if( blog_head && start_block_num <= blog_head->block_num() ) {
          ilog( "existing block log, attempting to replay from ${s} to ${n} blocks",
                ("s", start_block_num)("n", blog_head->block_num()) );
+         // blocks are read, unpacked and have their signatures recovered on the thread pool while the main thread
+         // applies the blocks before them
+         std::deque<std::future<replay_read_ahead_block>> read_ahead;
+         auto wait_for_read_ahead = fc::make_scoped_exit([&read_ahead]() {
+            for( auto& f : read_ahead )
+               f.wait();
+         });
+         uint32_t next_read_ahead_num = head->block_num + 1;
+         const uint32_t last_block_num = blog_head->block_num();
+         auto fill_read_ahead = [&]() {
+            while( read_ahead.size() < replay_read_ahead_blocks && next_read_ahead_num <= last_block_num ) {
+               read_ahead.emplace_back( post_async_task( thread_pool.get_executor(), [this, block_num = next_read_ahead_num]() {
+                  return read_ahead_block_for_replay( block_num );
+               } ) );
+               ++next_read_ahead_num;
+            }
+         };
          try {
-            while( auto next = blog.read_block_by_num( head->block_num + 1 ) ) {
-               replay_push_block( next, controller::block_status::irreversible );
+            fill_read_ahead();
+            while( !read_ahead.empty() ) {
+               replay_read_ahead_block next = read_ahead.front().get();
+               read_ahead.pop_front();
+               if( !next.block ) break;
+               fill_read_ahead();
+
+               trx_meta_cache_lookup trx_lookup;
+               if( !next.recovered_trxs.empty() ) {
+                  trx_lookup = [&recovered_trxs = next.recovered_trxs]( const transaction_id_type& id ) -> transaction_metadata_ptr {
+                     auto itr = recovered_trxs.find( id );
+                     return itr != recovered_trxs.end() ? itr->second.get() : transaction_metadata_ptr{};
+                  };
+               }
+               replay_push_block( next.block, controller::block_status::irreversible, trx_lookup );
                if( check_shutdown() ) break;
-               if( next->block_num() % 500 == 0 ) {
-                  ilog( "${n} of ${head}", ("n", next->block_num())("head", blog_head->block_num()) );
+               if( next.block->block_num() % 500 == 0 ) {
+                  ilog( "${n} of ${head}", ("n", next.block->block_num())("head", blog_head->block_num()) );
                }
             }
          } catch(  const database_guard_exception& e ) {
@@ -795,33 +879,262 @@ struct controller_impl {
                   */
    }
 
-   void add_contract_tables_to_snapshot( const snapshot_writer_ptr& snapshot ) const {
-      snapshot->write_section("contract_tables", [this]( auto& section ) {
-         index_utils<table_id_multi_index>::walk(db, [this, &section]( const table_id_object& table_row ){
-            // add a row for the table
-            section.add_row(table_row, db);
+   void add_contract_table_to_snapshot( snapshot_writer::section_writer& section, const table_id_object& table_row ) const {
+      // add a row for the table
+      section.add_row(table_row, db);
 
-            // followed by a size row and then N data rows for each type of table
-            contract_database_index_set::walk_indices([this, &section, &table_row]( auto utils ) {
-               using utils_t = decltype(utils);
-               using value_t = typename decltype(utils)::index_t::value_type;
-               using by_table_id = object_to_table_id_tag_t<value_t>;
+      // followed by a size row and then N data rows for each type of table
+      contract_database_index_set::walk_indices([this, &section, &table_row]( auto utils ) {
+         using utils_t = decltype(utils);
+         using value_t = typename decltype(utils)::index_t::value_type;
+         using by_table_id = object_to_table_id_tag_t<value_t>;
+
+         auto tid_key = boost::make_tuple(table_row.id);
+         auto next_tid_key = boost::make_tuple(table_id_object::id_type(table_row.id._id + 1));
 
-               auto tid_key = boost::make_tuple(table_row.id);
-               auto next_tid_key = boost::make_tuple(table_id_object::id_type(table_row.id._id + 1));
+         unsigned_int size = utils_t::template size_range<by_table_id>(db, tid_key, next_tid_key);
+         section.add_row(size, db);
+
+         utils_t::template walk_range<by_table_id>(db, tid_key, next_tid_key, [this, &section]( const auto &row ) {
+            section.add_row(row, db);
+         });
+      });
+   }
 
-               unsigned_int size = utils_t::template size_range<by_table_id>(db, tid_key, next_tid_key);
-               section.add_row(size, db);
+   using snapshot_part = std::function<void(const snapshot_writer_ptr&)>;
 
-               utils_t::template walk_range<by_table_id>(db, tid_key, next_tid_key, [this, &section]( const auto &row ) {
+   /**
+    *  The sections of a snapshot in order, as parts that write one or more sections each. The contract_tables section
+    *  is split into parts of about contract_tables_part_rows rows by ranges of table_id, the parts of a section have to
+    *  be appended back to back by a writer supporting buffered sections. The caller must guarantee the database is not
+    *  modified until all parts are written.
+    */
+   std::vector<snapshot_part> snapshot_parts( uint64_t contract_tables_part_rows ) const {
+      std::vector<snapshot_part> parts;
+
+      parts.emplace_back([this]( const snapshot_writer_ptr& w ) {
+         w->write_section<chain_snapshot_header>([this]( auto &section ){
+            section.add_row(chain_snapshot_header(), db);
+         });
+         w->write_section("eosio::chain::block_state", [this]( auto &section ){
+            section.template add_row<block_header_state_legacy>(*head, db);
+         });
+      });
+
+      controller_index_set::walk_indices([this, &parts]( auto utils ){
+         using value_t = typename decltype(utils)::index_t::value_type;
+
+         // skip the table_id_object as its inlined with contract tables section
+         if (std::is_same<value_t, table_id_object>::value) {
+            return;
+         }
+
+         // skip the database_header as it is only relevant to in-memory database
+         if (std::is_same<value_t, database_header_object>::value) {
+            return;
+         }
+
+         parts.emplace_back([this]( const snapshot_writer_ptr& w ) {
+            w->write_section<value_t>([this]( auto& section ){
+               decltype(utils)::walk(db, [this, &section]( const auto &row ) {
                   section.add_row(row, db);
                });
             });
          });
       });
+
+      // partition contract tables by table_id range, the first part always exists so the section is written even if empty
+      auto add_contract_tables_part = [this, &parts]( table_id_object::id_type begin, table_id_object::id_type end ) {
+         parts.emplace_back([this, begin, end]( const snapshot_writer_ptr& w ) {
+            w->write_section("contract_tables", [this, begin, end]( auto& section ) {
+               index_utils<table_id_multi_index>::walk_range<by_id>(db, begin, end, [this, &section]( const table_id_object& table_row ) {
+                  add_contract_table_to_snapshot(section, table_row);
+               });
+            });
+         });
+      };
+      table_id_object::id_type part_begin = 0;
+      uint64_t part_rows = 0;
+      if (contract_tables_part_rows != std::numeric_limits<uint64_t>::max()) {
+         index_utils<table_id_multi_index>::walk(db, [&]( const table_id_object& table_row ) {
+            part_rows += table_row.count + 1;
+            if (part_rows >= contract_tables_part_rows) {
+               table_id_object::id_type part_end(table_row.id._id + 1);
+               add_contract_tables_part(part_begin, part_end);
+               part_begin = part_end;
+               part_rows = 0;
+            }
+         });
+      }
+      if (part_rows > 0 || part_begin == table_id_object::id_type(0))
+         add_contract_tables_part(part_begin, table_id_object::id_type(std::numeric_limits<int64_t>::max()));
+
+      parts.emplace_back([this]( const snapshot_writer_ptr& w ) { authorization.add_to_snapshot(w); });
+      parts.emplace_back([this]( const snapshot_writer_ptr& w ) { resource_limits.add_to_snapshot(w); });
+
+      return parts;
+   }
+
+   /**
+    *  Serialize the snapshot_parts on the thread pool into buffered_snapshot_writers and append the results to
+    *  snapshot in order. ostream_snapshot_writer records the parts of the contract_tables section so they can be
+    *  loaded concurrently by read_contract_tables_from_snapshot_parallel. The number of parts in flight is bounded to
+    *  limit memory use; the main thread only waits and appends the serialized parts.
+    */
+   void add_to_snapshot_parallel( const snapshot_writer_ptr& snapshot ) {
+      const std::vector<snapshot_part> parts = snapshot_parts(conf.snapshot_contract_tables_part_rows);
+
+      using buffer_future = std::future<std::shared_ptr<buffered_snapshot_writer>>;
+      const size_t max_in_flight = 2 * conf.thread_pool_size;
+      std::deque<buffer_future> in_flight;
+      // parts reference this frame, never unwind before all submitted parts finished
+      auto wait_all = fc::make_scoped_exit([&in_flight]() {
+         for (auto& f : in_flight) {
+            if (f.valid())
+               f.wait();
+         }
+      });
+
+      auto next_part = parts.cbegin();
+      while (next_part != parts.cend() || !in_flight.empty()) {
+         while (next_part != parts.cend() && in_flight.size() < max_in_flight) {
+            in_flight.emplace_back(post_async_task(thread_pool.get_executor(), [&part = *next_part]() {
+               auto buffer = std::make_shared<buffered_snapshot_writer>();
+               part(buffer);
+               return buffer;
+            }));
+            ++next_part;
+         }
+         auto buffer = in_flight.front().get();
+         in_flight.pop_front();
+         snapshot->write_buffered_sections(*buffer);
+      }
+      snapshot->end_buffered_sections();
+   }
+
+   template<typename T>
+   struct snapshot_row_copier {
+      T&       dst;
+      const T& src;
+
+      template<typename Member, typename Class, Member (Class::*p)>
+      void operator()( const char* ) const {
+         dst.*p = src.*p;
+      }
+   };
+
+   // assign the reflected members of a row decoded by decode_contract_tables_chunk, the id is left untouched
+   template<typename T>
+   void assign_snapshot_row( T& row, typename detail::snapshot_row_traits<T>::snapshot_type& src ) {
+      if constexpr (std::is_same_v<typename detail::snapshot_row_traits<T>::snapshot_type, T>) {
+         fc::reflector<T>::visit(snapshot_row_copier<T>{row, src});
+      } else {
+         detail::snapshot_row_traits<T>::from_snapshot_row(std::move(src), row, db);
+      }
+   }
+
+   template<typename T>
+   static T& emplace_snapshot_row( std::vector<T>& rows ) {
+      if constexpr (std::is_default_constructible_v<T>) {
+         return rows.emplace_back();
+      } else {
+         return rows.emplace_back([](auto&) {}, chainbase::constructor_tag{});
+      }
+   }
+
+   // decode a chunk of the contract_tables section, safe to call on any thread as the database is not accessed
+   static std::shared_ptr<contract_tables_chunk> decode_contract_tables_chunk( const std::vector<char>& buf, uint64_t row_count ) {
+      auto chunk = std::make_shared<contract_tables_chunk>();
+      fc::datastream<const char*> ds(buf.data(), buf.size());
+      uint64_t rows = 0;
+      while (rows < row_count) {
+         fc::raw::unpack(ds, emplace_snapshot_row(chunk->tables));
+         ++rows;
+
+         contract_database_index_set::walk_indices([&]( auto utils ) {
+            using value_t = typename decltype(utils)::index_t::value_type;
+            auto& index_rows = std::get<std::vector<contract_tables_chunk::row_t<value_t>>>(chunk->rows);
+
+            auto& size = chunk->sizes.emplace_back();
+            fc::raw::unpack(ds, size);
+            ++rows;
+
+            for (uint32_t idx = 0; idx < size.value; ++idx) {
+               fc::raw::unpack(ds, emplace_snapshot_row(index_rows));
+            }
+            rows += size.value;
+         });
+      }
+      EOS_ASSERT(rows == row_count && ds.remaining() == 0, snapshot_exception,
+                 "Chunk of contract_tables snapshot section does not hold ${n} complete rows", ("n", row_count));
+      return chunk;
+   }
+
+   void insert_contract_tables_chunk( contract_tables_chunk& chunk ) {
+      auto next_size = chunk.sizes.cbegin();
+      std::array<size_t, contract_tables_chunk::index_count> next_row{};
+
+      for (auto& table : chunk.tables) {
+         table_id_object::id_type t_id;
+         index_utils<table_id_multi_index>::create(db, [this, &table, &t_id](auto& row) {
+            assign_snapshot_row(row, table);
+            t_id = row.id;
+         });
+
+         size_t index = 0;
+         contract_database_index_set::walk_indices([&]( auto utils ) {
+            using utils_t = decltype(utils);
+            using value_t = typename utils_t::index_t::value_type;
+            auto& index_rows = std::get<std::vector<contract_tables_chunk::row_t<value_t>>>(chunk.rows);
+
+            const uint32_t size = (next_size++)->value;
+            for (uint32_t idx = 0; idx < size; ++idx) {
+               utils_t::create(db, [&](auto& row) {
+                  row.t_id = t_id;
+                  assign_snapshot_row(row, index_rows[next_row[index]++]);
+               });
+            }
+            ++index;
+         });
+      }
+   }
+
+   /**
+    *  Load the contract_tables section from the chunks recorded in the snapshot directory. The main thread reads the
+    *  raw chunks and inserts the decoded rows in snapshot order, so table ids are assigned exactly as in the
+    *  sequential path; the thread pool decodes rows and pre-builds the objects. The number of chunks in flight is
+    *  bounded to limit memory use.
+    */
+   void read_contract_tables_from_snapshot_parallel( const snapshot_reader_ptr& snapshot, const std::vector<snapshot_section_chunk>& chunks ) {
+      using chunk_future = std::future<std::shared_ptr<contract_tables_chunk>>;
+      const size_t max_in_flight = 2 * conf.thread_pool_size;
+      std::deque<chunk_future> in_flight;
+
+      auto next_chunk = chunks.cbegin();
+      while (next_chunk != chunks.cend() || !in_flight.empty()) {
+         while (next_chunk != chunks.cend() && in_flight.size() < max_in_flight) {
+            std::vector<char> buf;
+            snapshot->read_section_chunk("contract_tables", *next_chunk, buf);
+            in_flight.emplace_back(post_async_task(thread_pool.get_executor(), [buf = std::move(buf), row_count = next_chunk->row_count]() {
+               return decode_contract_tables_chunk(buf, row_count);
+            }));
+            ++next_chunk;
+         }
+         auto chunk = in_flight.front().get();
+         in_flight.pop_front();
+         insert_contract_tables_chunk(*chunk);
+      }
    }
 
    void read_contract_tables_from_snapshot( const snapshot_reader_ptr& snapshot ) {
+      if (conf.thread_pool_size > 1) {
+         auto chunks = snapshot->section_chunks("contract_tables");
+         if (chunks.size() > 1) {
+            read_contract_tables_from_snapshot_parallel(snapshot, chunks);
+            return;
+         }
+      }
+
       snapshot->read_section("contract_tables", [this]( auto& section ) {
          bool more = !section.empty();
          while (more) {
@@ -854,38 +1167,17 @@ struct controller_impl {
       // clear in case the previous call to clear did not finish in time of deadline
       clear_expired_input_transactions( fc::time_point::maximum() );
 
-      snapshot->write_section<chain_snapshot_header>([this]( auto &section ){
-         section.add_row(chain_snapshot_header(), db);
-      });
-
-      snapshot->write_section("eosio::chain::block_state", [this]( auto &section ){
-         section.template add_row<block_header_state_legacy>(*head, db);
-      });
-
-      controller_index_set::walk_indices([this, &snapshot]( auto utils ){
-         using value_t = typename decltype(utils)::index_t::value_type;
-
-         // skip the table_id_object as its inlined with contract tables section
-         if (std::is_same<value_t, table_id_object>::value) {
-            return;
-         }
-
-         // skip the database_header as it is only relevant to in-memory database
-         if (std::is_same<value_t, database_header_object>::value) {
-            return;
-         }
-
-         snapshot->write_section<value_t>([this]( auto& section ){
-            decltype(utils)::walk(db, [this, &section]( const auto &row ) {
-               section.add_row(row, db);
-            });
-         });
-      });
-
-      add_contract_tables_to_snapshot(snapshot);
+      // writers with buffered sections always get the parts, whatever the size of the thread pool, so the
+      // snapshot and its section directory are the same on every node
+      if (snapshot->supports_buffered_sections()) {
+         add_to_snapshot_parallel(snapshot);
+         return;
+      }
 
-      authorization.add_to_snapshot(snapshot);
-      resource_limits.add_to_snapshot(snapshot);
+      // json and variant writers, the contract_tables section in one part
+      for (const auto& part : snapshot_parts(std::numeric_limits<uint64_t>::max())) {
+         part(snapshot);
+      }
    }
 
    static std::optional<genesis_state> extract_legacy_genesis_state( snapshot_reader& snapshot, uint32_t version ) {
@@ -2060,8 +2352,12 @@ struct controller_impl {
    }
 
 
+   // signature recovery started for the packed transactions of a fork branch, waited on by apply_block when it
+   // reaches each transaction
+   using branch_recovered_trxs = std::unordered_map<transaction_id_type, std::shared_future<transaction_metadata_ptr>>;
+
    void apply_block( controller::block_report& br, const block_state_legacy_ptr& bsp, controller::block_status s,
-                     const trx_meta_cache_lookup& trx_lookup )
+                     const trx_meta_cache_lookup& trx_lookup, const branch_recovered_trxs& branch_recovered = {} )
    { try {
       try {
          auto start = fc::time_point::now();
@@ -2077,7 +2373,7 @@ struct controller_impl {
          const bool existing_trxs_metas = !bsp->trxs_metas().empty();
          const bool pub_keys_recovered = bsp->is_pub_keys_recovered();
          const bool skip_auth_checks = self.skip_auth_check();
-         std::vector<std::tuple<transaction_metadata_ptr, recover_keys_future>> trx_metas;
+         std::vector<std::tuple<transaction_metadata_ptr, std::shared_future<transaction_metadata_ptr>>> trx_metas;
          bool use_bsp_cached = false;
          if( pub_keys_recovered || (skip_auth_checks && existing_trxs_metas) ) {
             use_bsp_cached = true;
@@ -2089,17 +2385,20 @@ struct controller_impl {
                   transaction_metadata_ptr trx_meta_ptr = trx_lookup ? trx_lookup( pt.id() ) : transaction_metadata_ptr{};
                   if( trx_meta_ptr && *trx_meta_ptr->packed_trx() != pt ) trx_meta_ptr = nullptr;
                   if( trx_meta_ptr && ( skip_auth_checks || !trx_meta_ptr->recovered_keys().empty() ) ) {
-                     trx_metas.emplace_back( std::move( trx_meta_ptr ), recover_keys_future{} );
+                     trx_metas.emplace_back( std::move( trx_meta_ptr ), std::shared_future<transaction_metadata_ptr>{} );
                   } else if( skip_auth_checks ) {
                      packed_transaction_ptr ptrx( b, &pt ); // alias signed_block_ptr
                      trx_metas.emplace_back(
                            transaction_metadata::create_no_recover_keys( std::move(ptrx), transaction_metadata::trx_type::input ),
-                           recover_keys_future{} );
+                           std::shared_future<transaction_metadata_ptr>{} );
+                  } else if( auto ritr = branch_recovered.find( pt.id() ); ritr != branch_recovered.end() ) {
+                     // started by start_branch_recover_keys, waited on below when the transaction is applied
+                     trx_metas.emplace_back( transaction_metadata_ptr{}, ritr->second );
                   } else {
                      packed_transaction_ptr ptrx( b, &pt ); // alias signed_block_ptr
                      auto fut = transaction_metadata::start_recover_keys(
                            std::move( ptrx ), thread_pool.get_executor(), chain_id, fc::microseconds::maximum(), transaction_metadata::trx_type::input  );
-                     trx_metas.emplace_back( transaction_metadata_ptr{}, std::move( fut ) );
+                     trx_metas.emplace_back( transaction_metadata_ptr{}, fut.share() );
                   }
                }
             }
@@ -2275,7 +2574,7 @@ struct controller_impl {
       } FC_LOG_AND_RETHROW( )
    }
 
-   void replay_push_block( const signed_block_ptr& b, controller::block_status s ) {
+   void replay_push_block( const signed_block_ptr& b, controller::block_status s, const trx_meta_cache_lookup& trx_lookup = {} ) {
       self.validate_db_available_size();
 
       EOS_ASSERT(!pending, block_validate_exception, "it is not valid to push a block when there is a pending block");
@@ -2312,7 +2611,7 @@ struct controller_impl {
 
          controller::block_report br;
          if( s == controller::block_status::irreversible ) {
-            apply_block( br, bsp, s, trx_meta_cache_lookup{} );
+            apply_block( br, bsp, s, trx_lookup );
 
             // On replay, log_irreversible is not called and so no irreversible_block signal is emitted.
             // So emit it explicitly here.
@@ -2331,6 +2630,34 @@ struct controller_impl {
       } FC_LOG_AND_RETHROW( )
    }
 
+   // apply_block only starts key recovery for the block it is applying, so switching to a branch of several
+   // unvalidated blocks would wait on recovery once per block. Start recovery for the whole branch up front on the
+   // thread pool, skipping transactions trx_lookup already has recovered keys for.
+   branch_recovered_trxs start_branch_recover_keys( const branch_type& branch, const trx_meta_cache_lookup& trx_lookup ) {
+      branch_recovered_trxs recovered;
+      if( branch.size() < 2 || self.skip_auth_check() )
+         return recovered;
+
+      for( const auto& bsp : branch ) {
+         if( bsp->is_pub_keys_recovered() )
+            continue;
+         for( const auto& receipt : bsp->block->transactions ) {
+            if( !std::holds_alternative<packed_transaction>(receipt.trx) )
+               continue;
+            const auto& pt = std::get<packed_transaction>(receipt.trx);
+            if( trx_lookup ) {
+               transaction_metadata_ptr trx_meta_ptr = trx_lookup( pt.id() );
+               if( trx_meta_ptr && *trx_meta_ptr->packed_trx() == pt && !trx_meta_ptr->recovered_keys().empty() )
+                  continue;
+            }
+            packed_transaction_ptr ptrx( bsp->block, &pt ); // alias signed_block_ptr
+            recovered.emplace( pt.id(), transaction_metadata::start_recover_keys(
+                  std::move( ptrx ), thread_pool.get_executor(), chain_id, fc::microseconds::maximum(), transaction_metadata::trx_type::input ).share() );
+         }
+      }
+      return recovered;
+   }
+
    void maybe_switch_forks( controller::block_report& br, const block_state_legacy_ptr& new_head, controller::block_status s,
                             const forked_branch_callback& forked_branch_cb, const trx_meta_cache_lookup& trx_lookup )
    {
@@ -2364,12 +2691,14 @@ struct controller_impl {
             if( forked_branch_cb ) forked_branch_cb( branches.second );
          }
 
+         const branch_recovered_trxs branch_recovered = start_branch_recover_keys( branches.first, trx_lookup );
+
          for( auto ritr = branches.first.rbegin(); ritr != branches.first.rend(); ++ritr ) {
             auto except = std::exception_ptr{};
             try {
                br = controller::block_report{};
                apply_block( br, *ritr, (*ritr)->is_valid() ? controller::block_status::validated
-                                                           : controller::block_status::complete, trx_lookup );
+                                                           : controller::block_status::complete, trx_lookup, branch_recovered );
             } catch ( const std::bad_alloc& ) {
               throw;
             } catch ( const boost::interprocess::bad_alloc& ) {
@@ -2760,6 +3089,14 @@ subjective_billing& controller::get_mutable_subjective_billing() {
    return my->subjective_bill;
 }
 
+versioned_abi_cache& controller::get_abi_cache() {
+   return my->abi_cache;
+}
+
+const versioned_abi_cache& controller::get_abi_cache()const {
+   return my->abi_cache;
+}
+
 
 controller::controller( const controller::config& cfg, const chain_id_type& chain_id )
 :my( new controller_impl( cfg, *this, protocol_feature_set{}, chain_id ) )
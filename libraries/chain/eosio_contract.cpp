@@ -233,6 +233,7 @@ void apply_eosio_setabi(apply_context& context) {
    db.modify( account_metadata, [&]( auto& a ) {
       a.abi_sequence += 1;
    });
+   context.control.get_abi_cache().invalidate(act.account);
 
    if (new_size != old_size) {
       if (auto dm_logger = context.control.get_deep_mind_logger(context.trx_context.is_transient())) {
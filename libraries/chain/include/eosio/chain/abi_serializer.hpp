@@ -3,6 +3,9 @@
 #include <eosio/chain/trace.hpp>
 #include <eosio/chain/contract_types.hpp>
 #include <eosio/chain/exceptions.hpp>
+#include <array>
+#include <mutex>
+#include <memory>
 #include <utility>
 #include <fc/variant_object.hpp>
 #include <fc/scoped_exit.hpp>
@@ -25,6 +28,7 @@ namespace impl {
    struct binary_to_variant_context;
    struct variant_to_binary_context;
    struct action_data_to_variant_context;
+   struct binary_to_variant_plan;
 }
 
 /**
@@ -150,6 +154,12 @@ private:
    map<type_name, pair<unpack_function, pack_function>, std::less<>> built_in_types;
    void configure_built_in_types();
 
+   /// every type reachable from the ABI resolved once into an index based plan, shared by copies of this serializer
+   std::shared_ptr<const impl::binary_to_variant_plan> decode_plan;
+   void compile_binary_to_variant_plan();
+   /// decodes with decode_plan if possible, falls back to the type name driven _binary_to_variant
+   fc::variant _binary_to_variant_with_plan( const std::string_view& type, fc::datastream<const char*>& binary, impl::binary_to_variant_context& ctx )const;
+
    fc::variant _binary_to_variant( const std::string_view& type, const bytes& binary, impl::binary_to_variant_context& ctx )const;
    fc::variant _binary_to_variant( const std::string_view& type, fc::datastream<const char*>& binary, impl::binary_to_variant_context& ctx )const;
    void        _binary_to_variant( const std::string_view& type, fc::datastream<const char*>& stream,
@@ -183,6 +193,8 @@ namespace impl {
 
       void check_deadline()const { yield( recursion_depth ); }
       abi_serializer::yield_function_t get_yield_function() { return yield; }
+      const abi_serializer::yield_function_t& get_yield_function_ref()const { return yield; }
+      size_t get_recursion_depth()const { return recursion_depth; }
 
       fc::scoped_exit<std::function<void()>> enter_scope();
 
@@ -1002,8 +1014,9 @@ void abi_serializer::from_variant( const fc::variant& v, T& o, const Resolver& r
    impl::abi_from_variant::extract(v, o, resolver, ctx);
 } FC_RETHROW_EXCEPTIONS(error, "Failed to deserialize variant", ("variant",v))
 
-using abi_serializer_cache_t = std::unordered_map<account_name, std::optional<abi_serializer>>;
-using resolver_fn_t = std::function<std::optional<abi_serializer>(const account_name& name)>;
+using abi_serializer_ptr = std::shared_ptr<const abi_serializer>;
+using abi_serializer_cache_t = std::unordered_map<account_name, abi_serializer_ptr>;
+using resolver_fn_t = std::function<abi_serializer_ptr(const account_name& name)>;
    
 class abi_resolver {
 public:
@@ -1095,13 +1108,10 @@ public:
             return *it->second;
          return {};
       }
-      auto serializer = resolver_(account);
       auto& dest = abi_serializers[account]; // add entry regardless
-      if (serializer) {
-         // we got a serializer, so move it into the cache
-         dest = abi_serializer_cache_t::mapped_type{std::move(*serializer)};
-         return *dest; // and return a reference to it
-      }
+      dest = resolver_(account);
+      if (dest)
+         return *dest;
       return {}; 
    };
 
@@ -1109,6 +1119,96 @@ private:
    const resolver_fn_t resolver_;
    mutable abi_serializer_cache_t abi_serializers;
 };
+
+/*
+ * Process wide cache of abi_serializers keyed by (account, abi_sequence). Entries are immutable and handed out as
+ * shared_ptr<const abi_serializer> so they can outlive eviction. Lookups may be done from any thread in the read
+ * window, each slot is guarded by one of a set of striped mutexes held only to copy the shared_ptr; invalidate() is
+ * called from the write window when a setabi is applied, which also covers an abi_sequence being reused with a
+ * different abi after a fork switch. A serializer built outside the read window is inserted with the slot generation
+ * taken in the read window, and is dropped if the slot was invalidated in between.
+ * The table is direct mapped on account name, a colliding account simply replaces the previous entry.
+ */
+class versioned_abi_cache {
+public:
+   static constexpr size_t slot_count = 4096;
+
+   /// @param build called on a miss, returns the serializer for the current abi of `account` or nullptr
+   template<typename Builder>
+   abi_serializer_ptr get(const account_name& account, uint64_t abi_sequence, Builder&& build) const {
+      if (abi_serializer_ptr serializer = find(account, abi_sequence))
+         return serializer;
+      abi_serializer_ptr serializer = build();
+      insert(account, abi_sequence, serializer);
+      return serializer;
+   }
+
+   /// @return cached serializer of `account` at `abi_sequence`, nullptr on a miss
+   abi_serializer_ptr find(const account_name& account, uint64_t abi_sequence) const {
+      if (auto e = load(slot_index(account)); e && e->account == account && e->abi_sequence == abi_sequence)
+         return e->serializer;
+      return {};
+   }
+
+   /// caches a serializer built in the read window outside of get(), ignored when nullptr
+   void insert(const account_name& account, uint64_t abi_sequence, abi_serializer_ptr serializer) const {
+      if (serializer)
+         store(slot_index(account), std::make_shared<const entry>(entry{account, abi_sequence, std::move(serializer)}));
+   }
+
+   /// @return generation of the slot of `account`, advanced by every invalidate() or clear() of it; take it in the
+   ///         read window to insert a serializer built outside of it
+   uint64_t generation(const account_name& account) const {
+      const size_t i = slot_index(account);
+      std::lock_guard g(stripes[i % stripe_count]);
+      return generations[i];
+   }
+
+   /// caches a serializer built outside the read window, ignored when nullptr or when the slot of `account` was
+   /// invalidated since `generation` was taken
+   void insert(const account_name& account, uint64_t abi_sequence, abi_serializer_ptr serializer, uint64_t generation) const {
+      if (!serializer)
+         return;
+      const size_t i = slot_index(account);
+      auto e = std::make_shared<const entry>(entry{account, abi_sequence, std::move(serializer)});
+      std::lock_guard g(stripes[i % stripe_count]);
+      if (generations[i] == generation)
+         slots[i] = std::move(e);
+   }
+
+   void invalidate(const account_name& account);
+   void clear();
+
+private:
+   struct entry {
+      account_name       account;
+      uint64_t           abi_sequence = 0;
+      abi_serializer_ptr serializer;
+   };
+   using entry_ptr = std::shared_ptr<const entry>;
+
+   static constexpr size_t stripe_count = 64;
+
+   static size_t slot_index(const account_name& account) {
+      // fibonacci hashing, low bits of names are often zero
+      return (account.to_uint64_t() * 0x9E3779B97F4A7C15ull) >> (64 - 12);
+   }
+   static_assert(slot_count == (1u << 12));
+
+   entry_ptr load(size_t i) const {
+      std::lock_guard g(stripes[i % stripe_count]);
+      return slots[i];
+   }
+   void store(size_t i, entry_ptr e) const {
+      std::lock_guard g(stripes[i % stripe_count]);
+      slots[i] = std::move(e);
+   }
+
+   // cache is logically const, lookups fill it in
+   mutable std::array<std::mutex, stripe_count> stripes;
+   mutable std::array<entry_ptr, slot_count>    slots;
+   std::array<uint64_t, slot_count>             generations{};
+};
       
 
 } // eosio::chain
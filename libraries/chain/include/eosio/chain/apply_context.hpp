@@ -7,6 +7,7 @@
 #include <fc/utility.hpp>
 #include <sstream>
 #include <algorithm>
+#include <memory>
 #include <set>
 
 namespace chainbase { class database; }
@@ -57,6 +58,19 @@ class apply_context {
                return _end_iterator_to_table[indx];
             }
 
+            /// Forgets all tables and iterators, keeping the allocated capacity unless it grew large
+            void reset() {
+               _table_cache.clear();
+               _end_iterator_to_table.clear();
+               _iterator_to_object.clear();
+               _object_to_iterator.clear();
+               if( _iterator_to_object.capacity() > max_retained_iterators ) {
+                  decltype(_iterator_to_object)().swap( _iterator_to_object );
+                  _iterator_to_object.reserve(32);
+                  decltype(_object_to_iterator)().swap( _object_to_iterator );
+               }
+            }
+
             const T& get( int iterator ) {
                EOS_ASSERT( iterator != -1, invalid_table_iterator, "invalid iterator" );
                EOS_ASSERT( iterator >= 0, table_operation_not_permitted, "dereference of end iterator" );
@@ -89,10 +103,12 @@ class apply_context {
             }
 
          private:
-            map<table_id_object::id_type, pair<const table_id_object*, int>> _table_cache;
+            static constexpr size_t max_retained_iterators = 1024;
+
+            flat_map<table_id_object::id_type, pair<const table_id_object*, int>> _table_cache;
             vector<const table_id_object*>                  _end_iterator_to_table;
             vector<const T*>                                _iterator_to_object;
-            map<const T*,int>                               _object_to_iterator;
+            unordered_map<const T*,int>                     _object_to_iterator;
 
             /// Precondition: std::numeric_limits<int>::min() < ei < -1
             /// Iterator of -1 is reserved for invalid iterators (i.e. when the appropriate table has not yet been created).
@@ -101,6 +117,31 @@ class apply_context {
             inline int index_to_end_iterator( size_t indx )const { return -(indx + 2); }
       }; /// class iterator_cache
 
+      /// All iterator caches of an apply_context. Pooled per thread and reset between actions so the
+      /// allocations are reused, see acquire_iterator_caches()
+      struct iterator_caches {
+         iterator_cache<key_value_object>         keyval;
+         iterator_cache<index64_object>           idx64;
+         iterator_cache<index128_object>          idx128;
+         iterator_cache<index256_object>          idx256;
+         iterator_cache<index_double_object>      idx_double;
+         iterator_cache<index_long_double_object> idx_long_double;
+
+         void reset() {
+            keyval.reset();
+            idx64.reset();
+            idx128.reset();
+            idx256.reset();
+            idx_double.reset();
+            idx_long_double.reset();
+         }
+      };
+
+      static constexpr size_t max_pooled_iterator_caches = 16;
+      static std::vector<std::unique_ptr<iterator_caches>>& iterator_caches_pool();
+      static std::unique_ptr<iterator_caches> acquire_iterator_caches();
+      static void release_iterator_caches( std::unique_ptr<iterator_caches> caches );
+
       template<typename>
       struct array_size;
 
@@ -173,7 +214,7 @@ class apply_context {
 
             using secondary_key_helper_t = secondary_key_helper<secondary_key_type, secondary_key_proxy_type, secondary_key_proxy_const_type>;
 
-            generic_index( apply_context& c ):context(c){}
+            generic_index( apply_context& c, iterator_cache<ObjectType>& cache ):context(c),itr_cache(cache){}
 
             int store( uint64_t scope, uint64_t table, const account_name& payer,
                        uint64_t id, secondary_key_proxy_const_type value )
@@ -486,13 +527,14 @@ class apply_context {
 
          private:
             apply_context&              context;
-            iterator_cache<ObjectType>  itr_cache;
+            iterator_cache<ObjectType>& itr_cache;
       }; /// class generic_index
 
 
    /// Constructor
    public:
       apply_context(controller& con, transaction_context& trx_ctx, uint32_t action_ordinal, uint32_t depth=0);
+      ~apply_context();
 
    /// Execution methods:
    public:
@@ -618,6 +660,7 @@ class apply_context {
       uint32_t                      action_ordinal = 0;
       bool                          privileged   = false;
       bool                          context_free = false;
+      std::unique_ptr<iterator_caches> itr_caches; ///< must be initialized before the generic_index members
 
    public:
       std::vector<char>             action_return_value;
@@ -629,7 +672,7 @@ class apply_context {
 
    private:
 
-      iterator_cache<key_value_object>    keyval_cache;
+      iterator_cache<key_value_object>&   keyval_cache;
       vector< std::pair<account_name, uint32_t> > _notified; ///< keeps track of new accounts to be notifed of current message
       vector<uint32_t>                    _inline_actions; ///< action_ordinals of queued inline actions
       vector<uint32_t>                    _cfa_inline_actions; ///< action_ordinals of queued inline context-free actions
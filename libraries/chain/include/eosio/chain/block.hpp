@@ -2,6 +2,8 @@
 #include <eosio/chain/block_header.hpp>
 #include <eosio/chain/transaction.hpp>
 
+#include <mutex>
+
 namespace eosio { namespace chain {
 
    /**
@@ -84,6 +86,43 @@ namespace eosio { namespace chain {
 
    using block_extension = block_extension_types::block_extension_t;
 
+   /**
+    * Serialized form of a signed_block, shared by p2p relay, block log and state history so that a block is
+    * packed at most once per node. A block copied, moved or assigned into starts with an empty cache since blocks
+    * are copied or moved in order to be modified.
+    */
+   class packed_block_cache {
+   public:
+      packed_block_cache() = default;
+      packed_block_cache( const packed_block_cache& ) {}
+      packed_block_cache( packed_block_cache&& ) noexcept {}
+      packed_block_cache& operator=( const packed_block_cache& ) {
+         set( {} );
+         return *this;
+      }
+      packed_block_cache& operator=( packed_block_cache&& ) noexcept {
+         set( {} );
+         return *this;
+      }
+
+      template<typename Pack>
+      std::shared_ptr<const bytes> get_or_pack( Pack&& pack ) const {
+         std::scoped_lock g( mtx );
+         if( !packed )
+            packed = std::make_shared<const bytes>( pack() );
+         return packed;
+      }
+
+      void set( std::shared_ptr<const bytes> p ) const {
+         std::scoped_lock g( mtx );
+         packed = std::move( p );
+      }
+
+   private:
+      mutable std::mutex                   mtx;
+      mutable std::shared_ptr<const bytes> packed;
+   };
+
    /**
     */
    struct signed_block : public signed_block_header{
@@ -101,6 +140,16 @@ namespace eosio { namespace chain {
       extensions_type               block_extensions;
 
       flat_multimap<uint16_t, block_extension> validate_and_extract_extensions()const;
+
+      /// thread safe, packs the block on first call; only call once the block is complete and no longer modified
+      std::shared_ptr<const bytes> packed_block()const;
+      /// thread safe, provide the serialized form of the block, e.g. the bytes it was unpacked from
+      void set_packed_block( std::shared_ptr<const bytes> packed )const { packed_cache.set( std::move(packed) ); }
+      /// thread safe, drops the cached bytes once no longer needed, a later packed_block() packs again
+      void release_packed_block()const { packed_cache.set( {} ); }
+
+   private:
+      packed_block_cache            packed_cache; // not reflected
    };
    using signed_block_ptr = std::shared_ptr<signed_block>;
 
@@ -36,7 +36,9 @@ namespace eosio { namespace chain {
     * how many blocks at the end of the log are valid. Any earlier blocks in the log are assumed destroyed
     * and unreadable due to reclamation for purposes of saving space.
     *
-    * Object thread-safe. Not safe to have multiple block_log objects to same data_dir.
+    * Object thread-safe. Not safe to have multiple block_log objects to same data_dir. Block reads use positional
+    * I/O on the log and index files so any number of readers may decode blocks concurrently; only append, reset
+    * and flush are serialized.
     */
 
 
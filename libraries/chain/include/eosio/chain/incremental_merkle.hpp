@@ -146,7 +146,7 @@ class incremental_merkle_impl {
 
                // calculate the partially realized node value by implying the "right" value is identical
                // to the "left" value
-               top = DigestType::hash(make_canonical_pair(top, top));
+               top = hash_canonical_pair(top, top);
                partial = true;
             } else {
                // we are collapsing from a "right" value and an fully-realized "left"
@@ -162,7 +162,7 @@ class incremental_merkle_impl {
                }
 
                // calculate the node
-               top = DigestType::hash(make_canonical_pair(left_value, top));
+               top = hash_canonical_pair(left_value, top);
             }
 
             // move up a level in the tree
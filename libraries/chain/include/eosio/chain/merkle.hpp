@@ -14,6 +14,11 @@ namespace eosio { namespace chain {
       return make_pair(make_canonical_left(l), make_canonical_right(r));
    };
 
+   /**
+    *  Equivalent to digest_type::hash(make_canonical_pair(l, r)) without going through a streaming sha256 encoder
+    */
+   digest_type hash_canonical_pair(const digest_type& l, const digest_type& r);
+
    /**
     *  Calculates the merkle root of a set of digests, if ids is odd it will duplicate the last id.
     */
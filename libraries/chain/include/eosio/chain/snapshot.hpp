@@ -4,7 +4,9 @@
 #include <eosio/chain/exceptions.hpp>
 #include <fc/variant_object.hpp>
 #include <boost/core/demangle.hpp>
+#include <map>
 #include <ostream>
+#include <sstream>
 #include <memory>
 
 namespace eosio { namespace chain {
@@ -14,6 +16,29 @@ namespace eosio { namespace chain {
     */
    static const uint32_t current_snapshot_version = 1;
 
+   /**
+    * A range of whole rows of a section. ostream_snapshot_writer records the buffered parts every section was appended
+    * in, in a directory section, so readers can decode them concurrently. The directory is written whenever buffered
+    * sections were appended, however many parts a section has. Readers that do not know the directory ignore it like
+    * any other unknown section.
+    *
+    * History:
+    * Version 1: one row holding the directory version followed by one snapshot_section_directory_entry per section
+    */
+   static const uint32_t current_snapshot_section_directory_version = 1;
+   static const char snapshot_section_directory_name[] = "eosio::chain::snapshot_section_directory";
+
+   struct snapshot_section_chunk {
+      uint64_t offset    = 0; ///< byte offset of the first row of the chunk from the first row of the section
+      uint64_t size      = 0; ///< size in bytes of the rows of the chunk
+      uint64_t row_count = 0;
+   };
+
+   struct snapshot_section_directory_entry {
+      std::string                         section;
+      std::vector<snapshot_section_chunk> chunks;
+   };
+
    namespace detail {
       template<typename T>
       struct snapshot_section_traits {
@@ -113,6 +138,8 @@ namespace eosio { namespace chain {
       }
    }
 
+   class buffered_snapshot_writer;
+
    class snapshot_writer {
       public:
          class section_writer {
@@ -145,12 +172,30 @@ namespace eosio { namespace chain {
             write_section(detail::snapshot_section_traits<T>::section_name(), f);
          }
 
+         /**
+          * Writers returning true accept sections serialized ahead of time, possibly on other threads, by a
+          * buffered_snapshot_writer via write_buffered_sections()
+          */
+         virtual bool supports_buffered_sections() const { return false; }
+
+         /**
+          * Append the sections of a buffered_snapshot_writer. A buffered section with the same name as the last
+          * appended section continues that section, which allows a large section to be split into ranges of rows
+          * that are serialized independently. end_buffered_sections() must be called after the last buffer.
+          */
+         void write_buffered_sections( const buffered_snapshot_writer& buffer );
+         void end_buffered_sections();
+
       virtual ~snapshot_writer(){};
 
       protected:
          virtual void write_start_section( const std::string& section_name ) = 0;
          virtual void write_row( const detail::abstract_snapshot_row_writer& row_writer ) = 0;
          virtual void write_end_section() = 0;
+         virtual void write_buffered_rows( const char* data, size_t size, uint64_t row_count );
+
+      private:
+         std::optional<std::string> open_buffered_section;
    };
 
    using snapshot_writer_ptr = std::shared_ptr<snapshot_writer>;
@@ -277,6 +322,18 @@ namespace eosio { namespace chain {
 
       virtual void return_to_header() = 0;
 
+      /**
+       * The chunks of a section recorded in the snapshot's section directory, empty if the section was not written
+       * in chunks. The chunks of a section are contiguous and cover all of its rows.
+       */
+      virtual std::vector<snapshot_section_chunk> section_chunks( const std::string& section_name ) { return {}; }
+
+      /**
+       * Read the binary rows of a chunk returned by section_chunks() into buf. The rows can then be unpacked with
+       * fc::raw on any thread.
+       */
+      virtual void read_section_chunk( const std::string& section_name, const snapshot_section_chunk& chunk, std::vector<char>& buf );
+
       virtual ~snapshot_reader(){};
 
       protected:
@@ -329,6 +386,9 @@ namespace eosio { namespace chain {
          void write_end_section( ) override;
          void finalize();
 
+         bool supports_buffered_sections() const override { return true; }
+         void write_buffered_rows( const char* data, size_t size, uint64_t row_count ) override;
+
          static const uint32_t magic_number = 0x30510550;
 
       private:
@@ -336,6 +396,13 @@ namespace eosio { namespace chain {
          std::streampos          header_pos;
          std::streampos          section_pos;
          uint64_t                row_count;
+
+         // chunks of the current section when all of its rows were appended by write_buffered_rows
+         std::string                                   section_name;
+         std::streampos                                rows_pos;
+         bool                                          section_buffered = false;
+         std::vector<snapshot_section_chunk>           section_chunks;
+         std::vector<snapshot_section_directory_entry> directory;
    };
 
    class ostream_json_snapshot_writer : public snapshot_writer {
@@ -365,13 +432,25 @@ namespace eosio { namespace chain {
          void clear_section() override;
          void return_to_header() override;
 
+         std::vector<snapshot_section_chunk> section_chunks( const std::string& section_name ) override;
+         void read_section_chunk( const std::string& section_name, const snapshot_section_chunk& chunk, std::vector<char>& buf ) override;
+
       private:
+         struct section_info {
+            std::streampos rows_pos;
+            uint64_t       rows_size = 0;
+            uint64_t       row_count = 0;
+         };
+
          bool validate_section() const;
+         std::optional<section_info> find_section( const std::string& section_name ) const;
+         void load_directory();
 
          std::istream&  snapshot;
          std::streampos header_pos;
          uint64_t       num_rows;
          uint64_t       cur_row;
+         std::optional<std::map<std::string, std::vector<snapshot_section_chunk>>> directory;
    };
 
    class istream_json_snapshot_reader : public snapshot_reader {
@@ -401,9 +480,42 @@ namespace eosio { namespace chain {
          void write_end_section( ) override;
          void finalize();
 
+         bool supports_buffered_sections() const override { return true; }
+         void write_buffered_rows( const char* data, size_t size, uint64_t row_count ) override;
+
       private:
          fc::sha256::encoder&  enc;
 
    };
 
+   /**
+    * Serializes sections into memory using the binary row encoding shared by ostream_snapshot_writer and
+    * integrity_hash_snapshot_writer. Used to serialize sections, or ranges of rows of a section, on worker threads;
+    * the results are appended in order to the final writer with snapshot_writer::write_buffered_sections.
+    */
+   class buffered_snapshot_writer : public snapshot_writer {
+      public:
+         struct section {
+            std::string name;
+            std::string rows;
+            uint64_t    row_count = 0;
+         };
+
+         buffered_snapshot_writer();
+
+         void write_start_section( const std::string& section_name ) override;
+         void write_row( const detail::abstract_snapshot_row_writer& row_writer ) override;
+         void write_end_section( ) override;
+
+         const std::vector<section>& sections() const { return _sections; }
+
+      private:
+         std::ostringstream      _rows;
+         detail::ostream_wrapper _out;
+         std::vector<section>    _sections;
+   };
+
 }}
+
+FC_REFLECT(eosio::chain::snapshot_section_chunk, (offset)(size)(row_count))
+FC_REFLECT(eosio::chain::snapshot_section_directory_entry, (section)(chunks))
@@ -9,10 +9,9 @@
 
 #include <fc/time.hpp>
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/ordered_index.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <deque>
 
 namespace eosio::chain {
 
@@ -20,21 +19,19 @@ class subjective_billing {
 private:
 
    struct trx_cache_entry {
-      chain::transaction_id_type trx_id;
       chain::account_name        account;
       int64_t                    subjective_cpu_bill = 0;
-      fc::time_point             expiry;
+      uint32_t                   expire_sec = 0;   // selects the expiry bucket
+      uint32_t                   bucket_pos = 0;   // position of the trx id in its expiry bucket
    };
-   struct by_id;
-   struct by_expiry;
 
-   using trx_cache_index = bmi::multi_index_container<
-         trx_cache_entry,
-         indexed_by<
-               bmi::hashed_unique<tag<by_id>, BOOST_MULTI_INDEX_MEMBER( trx_cache_entry, chain::transaction_id_type, trx_id ) >,
-               ordered_non_unique<tag<by_expiry>, BOOST_MULTI_INDEX_MEMBER( trx_cache_entry, fc::time_point, expiry ) >
-         >
-   >;
+   using trx_cache_index = boost::unordered_flat_map<chain::transaction_id_type, trx_cache_entry>;
+
+   // Expiry wheel: one bucket of trx ids per second of expiry, _expiry_buckets[0] holds ids expiring at
+   // _expiry_base_sec. The wheel spans at most max_transaction_lifetime seconds of buckets and holds exactly the ids
+   // in _trx_cache_index: an id removed from the index, e.g. when its trx is included in a block, is removed from
+   // its bucket too, using the position kept in its trx_cache_entry.
+   using expiry_bucket = std::vector<chain::transaction_id_type>;
 
    using decaying_accumulator = chain::resource_limits::impl::exponential_decay_accumulator<>;
 
@@ -47,10 +44,12 @@ private:
       }
    };
 
-   using account_subjective_bill_cache = std::map<chain::account_name, subjective_billing_info>;
+   using account_subjective_bill_cache = boost::unordered_flat_map<chain::account_name, subjective_billing_info, std::hash<chain::account_name>>;
 
    bool                                      _disabled = false;
    trx_cache_index                           _trx_cache_index;
+   std::deque<expiry_bucket>                 _expiry_buckets;
+   uint32_t                                  _expiry_base_sec = 0;
    account_subjective_bill_cache             _account_subjective_bill_cache;
    std::set<chain::account_name>             _disabled_accounts;
    uint32_t                                  _expired_accumulator_average_window = chain::config::account_cpu_usage_average_window_ms / subjective_time_interval_ms;
@@ -80,6 +79,33 @@ private:
       }
    }
 
+   void add_to_expiry_wheel( const chain::transaction_id_type& id, trx_cache_entry& entry ) {
+      const uint32_t expire_sec = entry.expire_sec;
+      if( _expiry_buckets.empty() ) {
+         _expiry_base_sec = expire_sec;
+      } else if( expire_sec < _expiry_base_sec ) {
+         _expiry_buckets.insert( _expiry_buckets.begin(), _expiry_base_sec - expire_sec, expiry_bucket{} );
+         _expiry_base_sec = expire_sec;
+      }
+      const size_t slot = expire_sec - _expiry_base_sec;
+      if( slot >= _expiry_buckets.size() )
+         _expiry_buckets.resize( slot + 1 );
+      entry.bucket_pos = _expiry_buckets[slot].size();
+      _expiry_buckets[slot].push_back( id );
+   }
+
+   // swaps the last id of the bucket into the position of the removed one
+   void remove_from_expiry_wheel( const trx_cache_entry& entry ) {
+      expiry_bucket& bucket = _expiry_buckets[entry.expire_sec - _expiry_base_sec];
+      if( entry.bucket_pos + 1 != bucket.size() ) {
+         bucket[entry.bucket_pos] = bucket.back();
+         _trx_cache_index.find( bucket[entry.bucket_pos] )->second.bucket_pos = entry.bucket_pos;
+      }
+      bucket.pop_back();
+      if( bucket.empty() )
+         expiry_bucket{}.swap( bucket ); // release the capacity of a drained bucket
+   }
+
    void remove_subjective_billing( const chain::signed_block_ptr& block, uint32_t time_ordinal ) {
       if( !_trx_cache_index.empty() ) {
          for( const auto& receipt : block->transactions ) {
@@ -95,13 +121,19 @@ public: // public for tests
    static constexpr uint32_t subjective_time_interval_ms = 5'000;
    size_t get_account_cache_size() const {return _account_subjective_bill_cache.size();}
    void remove_subjective_billing( const chain::transaction_id_type& trx_id, uint32_t time_ordinal ) {
-      auto& idx = _trx_cache_index.get<by_id>();
-      auto itr = idx.find( trx_id );
-      if( itr != idx.end() ) {
-         remove_subjective_billing( *itr, time_ordinal );
-         idx.erase( itr );
+      auto itr = _trx_cache_index.find( trx_id );
+      if( itr != _trx_cache_index.end() ) {
+         remove_subjective_billing( itr->second, time_ordinal );
+         remove_from_expiry_wheel( itr->second );
+         _trx_cache_index.erase( itr );
       }
    }
+   size_t get_expiry_wheel_size() const {
+      size_t n = 0;
+      for( const auto& bucket : _expiry_buckets )
+         n += bucket.size();
+      return n;
+   }
 
 public:
    void disable() { _disabled = true; }
@@ -113,13 +145,10 @@ public:
    {
       if( !_disabled && !_disabled_accounts.count( first_auth ) ) {
          int64_t bill = std::max<int64_t>( 0, elapsed.count() );
-         auto p = _trx_cache_index.emplace(
-               trx_cache_entry{id,
-                               first_auth,
-                               bill,
-                               expire.to_time_point()} );
+         auto p = _trx_cache_index.emplace( id, trx_cache_entry{first_auth, bill, expire.sec_since_epoch()} );
          if( p.second ) {
             _account_subjective_bill_cache[first_auth].pending_cpu_us += bill;
+            add_to_expiry_wheel( id, p.first->second );
          }
       }
    }
@@ -164,22 +193,30 @@ public:
    template <typename Yield>
    bool remove_expired( fc::logger& log, const fc::time_point& pending_block_time, const fc::time_point& now, Yield&& yield ) {
       bool exhausted = false;
-      auto& idx = _trx_cache_index.get<by_expiry>();
-      if( !idx.empty() ) {
+      if( _trx_cache_index.empty() ) {
+         _expiry_buckets.clear(); // only empty buckets remain
+      } else {
          const auto time_ordinal = time_ordinal_for(now);
          const auto orig_count = _trx_cache_index.size();
+         const uint32_t pending_block_sec = pending_block_time.sec_since_epoch();
          uint32_t num_expired = 0;
 
-         while( !idx.empty() ) {
-            if( yield() ) {
-               exhausted = true;
-               break;
+         while( !_expiry_buckets.empty() && _expiry_base_sec <= pending_block_sec ) {
+            expiry_bucket& bucket = _expiry_buckets.front();
+            while( !bucket.empty() ) {
+               if( yield() ) {
+                  exhausted = true;
+                  break;
+               }
+               auto itr = _trx_cache_index.find( bucket.back() );
+               bucket.pop_back();
+               transition_to_expired( itr->second, time_ordinal );
+               _trx_cache_index.erase( itr );
+               num_expired++;
             }
-            auto b = idx.begin();
-            if( b->expiry > pending_block_time ) break;
-            transition_to_expired( *b, time_ordinal );
-            idx.erase( b );
-            num_expired++;
+            if( exhausted ) break;
+            _expiry_buckets.pop_front();
+            ++_expiry_base_sec;
          }
 
          fc_dlog( log, "Processed ${n} subjective billed transactions, Expired ${expired}",
@@ -188,6 +225,8 @@ public:
       return !exhausted;
    }
 
+   size_t get_trx_cache_size() const { return _trx_cache_index.size(); }
+
    uint32_t get_expired_accumulator_average_window() const {
       return _expired_accumulator_average_window;
    }
@@ -10,6 +10,8 @@ namespace eosio::benchmark {
 
 namespace eosio { namespace chain {
 
+   class table_id_object;
+
    struct transaction_checktime_timer {
       public:
          transaction_checktime_timer() = delete;
@@ -191,6 +193,20 @@ namespace eosio { namespace chain {
             speculative_executed_adjusted_max_transaction_time // prev_billed_cpu_time_us > 0
          };
          tx_cpu_usage_exceeded_reason  tx_cpu_usage_reason = tx_cpu_usage_exceeded_reason::account_cpu_limit;
+
+         using table_key = std::tuple<name, name, name>; // code, scope, table
+         struct table_key_hash {
+            size_t operator()( const table_key& k )const {
+               auto h = std::get<0>(k).to_uint64_t();
+               h = h * 0x9E3779B97F4A7C15ull ^ std::get<1>(k).to_uint64_t();
+               h = h * 0x9E3779B97F4A7C15ull ^ std::get<2>(k).to_uint64_t();
+               return h;
+            }
+         };
+         static constexpr size_t max_cached_tables = 4096;
+         /// memo of table lookups of all actions of the transaction, nullptr if the table does not exist.
+         /// apply_context keeps it in sync as it is the only one creating and removing tables during execution
+         unordered_map<table_key, const table_id_object*, table_key_hash> table_cache;
    };
 
 } }
@@ -8,6 +8,7 @@
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
 
 namespace fc {
   inline std::size_t hash_value( const fc::sha256& v ) {
@@ -63,10 +64,39 @@ private:
    uint64_t size_in_bytes = 0;
    size_t incoming_count = 0;
 
+   // Most recently aborted or forked out transactions, kept after they leave the queue so a block that includes
+   // them again (e.g. on a fork switch back) reuses the already recovered keys. Front is most recently used.
+   typedef multi_index_container< transaction_metadata_ptr,
+      indexed_by<
+         sequenced<>,
+         hashed_unique< tag<by_trx_id>,
+               const_mem_fun<transaction_metadata, const transaction_id_type&, &transaction_metadata::id>
+         >
+      >
+   > recent_trx_cache_type;
+
+   recent_trx_cache_type recent_trxs;
+   uint64_t max_recent_trxs_size = 256*1024*1024;
+   uint64_t recent_trxs_size_in_bytes = 0;
+
 public:
 
    void set_max_transaction_queue_size( uint64_t v ) { max_transaction_queue_size = v; }
 
+   /// bytes, as counted by calc_size, the recently aborted or forked out transactions are limited to
+   void set_max_recent_trxs_size( uint64_t v ) {
+      max_recent_trxs_size = v;
+      trim_recent_trxs();
+   }
+
+   size_t recent_trxs_size() const {
+      return recent_trxs.size();
+   }
+
+   uint64_t recent_trxs_bytes() const {
+      return recent_trxs_size_in_bytes;
+   }
+
    bool empty() const {
       return queue.empty();
    }
@@ -77,6 +107,8 @@ public:
 
    void clear() {
       queue.clear();
+      recent_trxs.clear();
+      recent_trxs_size_in_bytes = 0;
    }
 
    size_t incoming_size()const {
@@ -89,6 +121,17 @@ public:
       return itr->trx_meta;
    }
 
+   /// lookup for controller::push_block, also finds recently aborted or forked transactions no longer in the queue
+   transaction_metadata_ptr find_trx_meta( const transaction_id_type& id ) {
+      auto itr = queue.get<by_trx_id>().find( id );
+      if( itr != queue.get<by_trx_id>().end() ) return itr->trx_meta;
+      auto& by_id = recent_trxs.get<by_trx_id>();
+      auto ritr = by_id.find( id );
+      if( ritr == by_id.end() ) return {};
+      recent_trxs.relocate( recent_trxs.begin(), recent_trxs.project<0>( ritr ) );
+      return *ritr;
+   }
+
    template <typename Yield, typename Callback>
    bool clear_expired( const time_point& pending_block_time, Yield&& yield, Callback&& callback ) {
       auto& persisted_by_expiry = queue.get<by_expiry>();
@@ -139,6 +182,7 @@ public:
          const block_state_legacy_ptr& bsptr = *ritr;
          for( auto itr = bsptr->trxs_metas().begin(), end = bsptr->trxs_metas().end(); itr != end; ++itr ) {
             const auto& trx = *itr;
+            add_recent( trx );
             auto insert_itr = queue.insert( { trx, trx_enum_type::forked } );
             if( insert_itr.second ) added( insert_itr.first );
          }
@@ -147,6 +191,7 @@ public:
 
    void add_aborted( deque<transaction_metadata_ptr> aborted_trxs ) {
       for( auto& trx : aborted_trxs ) {
+         add_recent( trx );
          auto insert_itr = queue.insert( { std::move( trx ), trx_enum_type::aborted } );
          if( insert_itr.second ) added( insert_itr.first );
       }
@@ -192,6 +237,24 @@ public:
    }
 
 private:
+   void add_recent( const transaction_metadata_ptr& trx ) {
+      if( max_recent_trxs_size == 0 || trx->recovered_keys().empty() ) return;
+      auto [itr, inserted] = recent_trxs.push_front( trx );
+      if( !inserted ) {
+         recent_trxs.relocate( recent_trxs.begin(), itr );
+         return;
+      }
+      recent_trxs_size_in_bytes += calc_size( trx );
+      trim_recent_trxs();
+   }
+
+   void trim_recent_trxs() {
+      while( recent_trxs_size_in_bytes > max_recent_trxs_size ) {
+         recent_trxs_size_in_bytes -= calc_size( recent_trxs.back() );
+         recent_trxs.pop_back();
+      }
+   }
+
    template<typename Itr>
    void added( Itr itr ) {
       auto size = calc_size( itr->trx_meta );
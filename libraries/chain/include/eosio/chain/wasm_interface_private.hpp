@@ -22,6 +22,7 @@
 #include <eosio/chain/webassembly/eos-vm.hpp>
 #include <eosio/vm/allocator.hpp>
 
+#include <map>
 #include <mutex>
 
 using namespace fc;
@@ -108,7 +109,8 @@ struct eosvmoc_tier {
          // No need for an additional check if we should lock or not.
          std::lock_guard g(instantiation_cache_mutex);
          wasm_cache_index::iterator it = wasm_instantiation_cache.find( boost::make_tuple(code_hash, vm_type, vm_version) );
-         return it != wasm_instantiation_cache.end();
+         return it != wasm_instantiation_cache.end() ||
+                read_window_instantiation_cache.count( read_window_cache_key{code_hash, vm_type, vm_version} );
       }
 
       void code_block_num_last_used(const digest_type& code_hash, const uint8_t& vm_type, const uint8_t& vm_version, const uint32_t& block_num) {
@@ -116,6 +118,7 @@ struct eosvmoc_tier {
          // the transaction is not read-only, implying we are
          // in write window. Read-only threads are not running.
          // Safe to update the cache without locking.
+         merge_read_window_instantiation_cache();
          wasm_cache_index::iterator it = wasm_instantiation_cache.find(boost::make_tuple(code_hash, vm_type, vm_version));
          if(it != wasm_instantiation_cache.end())
             wasm_instantiation_cache.modify(it, [block_num](wasm_cache_entry& e) {
@@ -129,6 +132,7 @@ struct eosvmoc_tier {
          // in write window. Read-only threads are not running.
          // Safe to update the cache without locking.
          // Anything last used before or on the LIB can be evicted.
+         merge_read_window_instantiation_cache();
          const auto first_it = wasm_instantiation_cache.get<by_last_block_num>().begin();
          const auto last_it  = wasm_instantiation_cache.get<by_last_block_num>().upper_bound(lib);
 #ifdef EOSIO_EOS_VM_OC_RUNTIME_ENABLED
@@ -154,14 +158,59 @@ struct eosvmoc_tier {
             // When in write window (either read only threads are not enabled or
             // they are not schedued to run), only main thread is processing
             // transactions. No need to lock.
+            merge_read_window_instantiation_cache();
             return get_or_build_instantiated_module(code_hash, vm_type, vm_version, trx_context);
          } else {
+            // wasm_instantiation_cache is only modified in the write window, so while
+            // read-only threads run it can be searched concurrently without locking.
+            wasm_cache_index::iterator it = wasm_instantiation_cache.find( boost::make_tuple(code_hash, vm_type, vm_version) );
+            if (it != wasm_instantiation_cache.end()) {
+               assert(it->module);
+               return it->module;
+            }
+            // Modules first used in the read window are kept aside until the next write window.
             std::lock_guard g(instantiation_cache_mutex);
-            return get_or_build_instantiated_module(code_hash, vm_type, vm_version, trx_context);
+            read_window_cache_key key{code_hash, vm_type, vm_version};
+            auto rw_it = read_window_instantiation_cache.find(key);
+            if (rw_it != read_window_instantiation_cache.end())
+               return rw_it->second;
+            auto module = instantiate_module(code_hash, vm_type, vm_version, trx_context);
+            return read_window_instantiation_cache.emplace(std::move(key), std::move(module)).first->second;
+         }
+      }
+
+      // Moves modules instantiated by read-only threads into wasm_instantiation_cache.
+      // Only called in the write window, when read-only threads are not running.
+      void merge_read_window_instantiation_cache() {
+         if (read_window_instantiation_cache.empty())
+            return;
+         for (auto& [key, module] : read_window_instantiation_cache) {
+            wasm_instantiation_cache.emplace( wasm_interface_impl::wasm_cache_entry {
+               .code_hash = key.code_hash,
+               .last_block_num_used = UINT32_MAX,
+               .module = std::move(module),
+               .vm_type = key.vm_type,
+               .vm_version = key.vm_version
+            } );
          }
+         read_window_instantiation_cache.clear();
+      }
+
+      std::unique_ptr<wasm_instantiated_module_interface> instantiate_module(
+         const digest_type&   code_hash,
+         const uint8_t&       vm_type,
+         const uint8_t&       vm_version,
+         transaction_context& trx_context )
+      {
+         const code_object* codeobject = &db.get<code_object,by_code_hash>(boost::make_tuple(code_hash, vm_type, vm_version));
+         auto timer_pause = fc::make_scoped_exit([&](){
+            trx_context.resume_billing_timer();
+         });
+         trx_context.pause_billing_timer();
+         return runtime_interface->instantiate_module(codeobject->code.data(), codeobject->code.size(), code_hash, vm_type, vm_version);
       }
 
-      // Locked by the caller if required.
+      // Only called in the write window.
       const std::unique_ptr<wasm_instantiated_module_interface>& get_or_build_instantiated_module(
          const digest_type&   code_hash,
          const uint8_t&       vm_type,
@@ -175,21 +224,13 @@ struct eosvmoc_tier {
             return it->module;
          }
 
-         const code_object* codeobject = &db.get<code_object,by_code_hash>(boost::make_tuple(code_hash, vm_type, vm_version));
          it = wasm_instantiation_cache.emplace( wasm_interface_impl::wasm_cache_entry {
             .code_hash = code_hash,
             .last_block_num_used = UINT32_MAX,
-            .module = nullptr,
+            .module = instantiate_module(code_hash, vm_type, vm_version, trx_context),
             .vm_type = vm_type,
             .vm_version = vm_version
          } ).first;
-         auto timer_pause = fc::make_scoped_exit([&](){
-            trx_context.resume_billing_timer();
-         });
-         trx_context.pause_billing_timer();
-         wasm_instantiation_cache.modify(it, [&](auto& c) {
-            c.module = runtime_interface->instantiate_module(codeobject->code.data(), codeobject->code.size(), code_hash, vm_type, vm_version);
-         });
          return it->module;
       }
 
@@ -208,9 +249,20 @@ struct eosvmoc_tier {
             ordered_non_unique<tag<by_last_block_num>, member<wasm_cache_entry, uint32_t, &wasm_cache_entry::last_block_num_used>>
          >
       > wasm_cache_index;
-      mutable std::mutex instantiation_cache_mutex;
       wasm_cache_index wasm_instantiation_cache;
 
+      struct read_window_cache_key {
+         digest_type code_hash;
+         uint8_t     vm_type = 0;
+         uint8_t     vm_version = 0;
+
+         bool operator<(const read_window_cache_key& o) const {
+            return std::tie(code_hash, vm_type, vm_version) < std::tie(o.code_hash, o.vm_type, o.vm_version);
+         }
+      };
+      mutable std::mutex instantiation_cache_mutex; // protects read_window_instantiation_cache in the read window
+      std::map<read_window_cache_key, std::unique_ptr<wasm_instantiated_module_interface>> read_window_instantiation_cache;
+
       const chainbase::database& db;
       const wasm_interface::vm_type wasm_runtime_time;
 
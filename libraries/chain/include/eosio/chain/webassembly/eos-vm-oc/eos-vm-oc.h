@@ -39,6 +39,7 @@ struct eos_vm_oc_control_block {
    unsigned is_running;
    int64_t max_linear_memory_pages;
    void* globals;
+   int64_t max_used_linear_memory_pages; //high-water mark of current_linear_memory_pages for this execution
 };
 
 #ifdef __cplusplus
@@ -35,6 +35,10 @@ class memory {
 
       control_block* const get_control_block() const { return reinterpret_cast<control_block* const>(zeropage_base - cb_offset);}
 
+      //returns the first used_pages of linear memory backed by the memory slices to zero pages. Pages beyond the
+      // high-water mark of an execution were never touched and are already holes in the memfd, so they are skipped
+      void reset_sliced_memory(uint64_t used_pages);
+
       //these two are really only inteded for SEGV handling
       uint8_t* const start_of_memory_slices() const { return mapbase; }
       size_t size_of_memory_slice_mapping() const { return mapsize; }
@@ -60,6 +64,8 @@ class memory {
       static_assert(stride == EOS_VM_OC_MEMORY_STRIDE, "EOS VM OC memory stride has slid out of place somehow");
 
    private:
+      int      fd;
+      uint64_t sliced_memory_size;
       uint8_t* mapbase;
       uint64_t mapsize;
 
@@ -32,21 +32,37 @@ bool is_canonical_right(const digest_type& val) {
 }
 
 
+digest_type hash_canonical_pair(const digest_type& l, const digest_type& r) {
+   const digest_type pair[2] = { make_canonical_left(l), make_canonical_right(r) };
+   digest_type result;
+   digest_type::hash_64_bytes_batch(pair[0].data(), 1, &result);
+   return result;
+}
+
 digest_type merkle(deque<digest_type> ids) {
    if( 0 == ids.size() ) { return digest_type(); }
 
-   while( ids.size() > 1 ) {
-      if( ids.size() % 2 )
-         ids.push_back(ids.back());
+   static_assert(sizeof(digest_type) == 32, "pairs of digests are hashed as contiguous 64 byte messages");
+
+   // every level is a contiguous array of canonical (left, right) pairs, hashed as one batch into the next level
+   vector<digest_type> nodes(ids.begin(), ids.end());
+   vector<digest_type> parents;
+   while( nodes.size() > 1 ) {
+      if( nodes.size() % 2 )
+         nodes.push_back(nodes.back());
 
-      for (size_t i = 0; i < ids.size() / 2; i++) {
-         ids[i] = digest_type::hash(make_canonical_pair(ids[2 * i], ids[(2 * i) + 1]));
+      const size_t pair_count = nodes.size() / 2;
+      for (size_t i = 0; i < pair_count; i++) {
+         nodes[2 * i] = make_canonical_left(nodes[2 * i]);
+         nodes[(2 * i) + 1] = make_canonical_right(nodes[(2 * i) + 1]);
       }
 
-      ids.resize(ids.size() / 2);
+      parents.resize(pair_count);
+      digest_type::hash_64_bytes_batch(nodes.data()->data(), pair_count, parents.data());
+      std::swap(nodes, parents);
    }
 
-   return ids.front();
+   return nodes.front();
 }
 
 } } // eosio::chain
@@ -14,6 +14,33 @@ using namespace eosio_rapidjson;
 
 namespace eosio { namespace chain {
 
+void snapshot_writer::write_buffered_sections( const buffered_snapshot_writer& buffer ) {
+   EOS_ASSERT(supports_buffered_sections(), snapshot_exception, "Snapshot writer does not support buffered sections");
+   for( const auto& section : buffer.sections() ) {
+      if( !open_buffered_section || *open_buffered_section != section.name ) {
+         end_buffered_sections();
+         write_start_section(section.name);
+         open_buffered_section = section.name;
+      }
+      write_buffered_rows(section.rows.data(), section.rows.size(), section.row_count);
+   }
+}
+
+void snapshot_writer::end_buffered_sections() {
+   if( open_buffered_section ) {
+      write_end_section();
+      open_buffered_section.reset();
+   }
+}
+
+void snapshot_writer::write_buffered_rows( const char*, size_t, uint64_t ) {
+   EOS_THROW(snapshot_exception, "Snapshot writer does not support buffered sections");
+}
+
+void snapshot_reader::read_section_chunk( const std::string& section_name, const snapshot_section_chunk&, std::vector<char>& ) {
+   EOS_THROW(snapshot_exception, "Snapshot reader does not support reading section ${n} in chunks", ("n", section_name));
+}
+
 variant_snapshot_writer::variant_snapshot_writer(fc::mutable_variant_object& snapshot)
 : snapshot(snapshot)
 {
@@ -150,11 +177,23 @@ void ostream_snapshot_writer::write_start_section( const std::string& section_na
    // write the section name (null terminated)
    snapshot.write(section_name.data(), section_name.size());
    snapshot.put(0);
+
+   this->section_name = section_name;
+   rows_pos = snapshot.tellp();
+   section_buffered = true;
+   section_chunks.clear();
 }
 
 void ostream_snapshot_writer::write_row( const detail::abstract_snapshot_row_writer& row_writer ) {
    row_writer.write(snapshot);
    row_count++;
+   section_buffered = false;
+}
+
+void ostream_snapshot_writer::write_buffered_rows( const char* data, size_t size, uint64_t rows ) {
+   section_chunks.push_back({static_cast<uint64_t>(snapshot.tellp() - rows_pos), size, rows});
+   snapshot.write(data, size);
+   row_count += rows;
 }
 
 void ostream_snapshot_writer::write_end_section( ) {
@@ -174,9 +213,25 @@ void ostream_snapshot_writer::write_end_section( ) {
 
    section_pos = std::streampos(-1);
    row_count = 0;
+
+   // every buffered section is recorded so the directory does not depend on how many parts were written
+   if (section_buffered && !section_chunks.empty()) {
+      directory.push_back({std::move(section_name), std::move(section_chunks)});
+   }
+   section_chunks.clear();
 }
 
 void ostream_snapshot_writer::finalize() {
+   if (!directory.empty()) {
+      write_start_section(snapshot_section_directory_name);
+      write_row(detail::make_row_writer(current_snapshot_section_directory_version));
+      for (const auto& entry : directory) {
+         write_row(detail::make_row_writer(entry));
+      }
+      write_end_section();
+      directory.clear();
+   }
+
    uint64_t end_marker = std::numeric_limits<uint64_t>::max();
 
    // write a placeholder for the section size
@@ -275,7 +330,7 @@ bool istream_snapshot_reader::validate_section() const {
    return true;
 }
 
-void istream_snapshot_reader::set_section( const string& section_name ) {
+std::optional<istream_snapshot_reader::section_info> istream_snapshot_reader::find_section( const string& section_name ) const {
    auto restore_pos = fc::make_scoped_exit([this,pos=snapshot.tellg()](){
       snapshot.seekg(pos);
    });
@@ -306,16 +361,100 @@ void istream_snapshot_reader::set_section( const string& section_name ) {
       }
 
       if (match && snapshot.get() == 0) {
-         cur_row = 0;
-         num_rows = row_count;
+         section_info result;
+         result.rows_pos = snapshot.tellg();
+         result.rows_size = next_section_pos - result.rows_pos;
+         result.row_count = row_count;
+         return result;
+      }
+   }
+
+   return {};
+}
+
+void istream_snapshot_reader::set_section( const string& section_name ) {
+   auto section = find_section(section_name);
+   EOS_ASSERT(section, snapshot_exception, "Binary snapshot has no section named ${n}", ("n", section_name));
+
+   cur_row = 0;
+   num_rows = section->row_count;
+
+   // leave the stream at the right point
+   snapshot.seekg(section->rows_pos);
+}
+
+void istream_snapshot_reader::load_directory() {
+   directory.emplace();
 
-         // leave the stream at the right point
-         restore_pos.cancel();
+   auto dir = find_section(snapshot_section_directory_name);
+   if (!dir || dir->row_count == 0) {
+      return;
+   }
+
+   std::vector<snapshot_section_directory_entry> entries;
+   {
+      auto restore_pos = fc::make_scoped_exit([this,pos=snapshot.tellg()](){
+         snapshot.seekg(pos);
+      });
+      snapshot.seekg(dir->rows_pos);
+
+      uint32_t version = 0;
+      fc::raw::unpack(snapshot, version);
+      if (version != current_snapshot_section_directory_version) {
+         // unknown directory layout, all sections are still readable sequentially
          return;
       }
+
+      EOS_ASSERT(dir->row_count <= dir->rows_size, snapshot_exception, "Binary snapshot directory is corrupted");
+      entries.resize(dir->row_count - 1);
+      for (auto& entry : entries) {
+         fc::raw::unpack(snapshot, entry);
+      }
+   }
+
+   for (auto& entry : entries) {
+      auto section = find_section(entry.section);
+      EOS_ASSERT(section, snapshot_exception, "Binary snapshot directory references missing section ${n}", ("n", entry.section));
+
+      uint64_t offset = 0;
+      uint64_t row_count = 0;
+      for (const auto& chunk : entry.chunks) {
+         EOS_ASSERT(chunk.offset == offset, snapshot_exception,
+                    "Binary snapshot directory has non-contiguous chunks for section ${n}", ("n", entry.section));
+         offset += chunk.size;
+         row_count += chunk.row_count;
+      }
+      EOS_ASSERT(offset == section->rows_size && row_count == section->row_count, snapshot_exception,
+                 "Binary snapshot directory does not match section ${n}", ("n", entry.section));
+
+      (*directory)[entry.section] = std::move(entry.chunks);
    }
+}
 
-   EOS_THROW(snapshot_exception, "Binary snapshot has no section named ${n}", ("n", section_name));
+std::vector<snapshot_section_chunk> istream_snapshot_reader::section_chunks( const string& section_name ) {
+   if (!directory) {
+      load_directory();
+   }
+   auto itr = directory->find(section_name);
+   if (itr == directory->end()) {
+      return {};
+   }
+   return itr->second;
+}
+
+void istream_snapshot_reader::read_section_chunk( const string& section_name, const snapshot_section_chunk& chunk, std::vector<char>& buf ) {
+   auto section = find_section(section_name);
+   EOS_ASSERT(section && chunk.offset <= section->rows_size && chunk.size <= section->rows_size - chunk.offset, snapshot_exception,
+              "Binary snapshot has no chunk at offset ${o} of section ${n}", ("o", chunk.offset)("n", section_name));
+
+   auto restore_pos = fc::make_scoped_exit([this,pos=snapshot.tellg()](){
+      snapshot.seekg(pos);
+   });
+   snapshot.seekg(section->rows_pos + std::streamoff(chunk.offset));
+   buf.resize(chunk.size);
+   snapshot.read(buf.data(), buf.size());
+   EOS_ASSERT(static_cast<uint64_t>(snapshot.gcount()) == chunk.size, snapshot_exception,
+              "Binary snapshot is truncated in section ${n}", ("n", section_name));
 }
 
 bool istream_snapshot_reader::read_row( detail::abstract_snapshot_row_reader& row_reader ) {
@@ -440,8 +579,37 @@ void integrity_hash_snapshot_writer::write_end_section( ) {
    // no-op for structural details
 }
 
+void integrity_hash_snapshot_writer::write_buffered_rows( const char* data, size_t size, uint64_t ) {
+   while( size > 0 ) {
+      const uint32_t n = std::min<size_t>(size, std::numeric_limits<uint32_t>::max());
+      enc.write(data, n);
+      data += n;
+      size -= n;
+   }
+}
+
 void integrity_hash_snapshot_writer::finalize() {
    // no-op for structural details
 }
 
+buffered_snapshot_writer::buffered_snapshot_writer()
+:_out(_rows)
+{
+}
+
+void buffered_snapshot_writer::write_start_section( const std::string& section_name ) {
+   _sections.emplace_back(section{ .name = section_name });
+   _rows.str({});
+}
+
+void buffered_snapshot_writer::write_row( const detail::abstract_snapshot_row_writer& row_writer ) {
+   row_writer.write(_out);
+   ++_sections.back().row_count;
+}
+
+void buffered_snapshot_writer::write_end_section( ) {
+   _sections.back().rows = _rows.str();
+   _rows.str({});
+}
+
 }}
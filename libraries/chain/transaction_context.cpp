@@ -408,6 +408,7 @@ namespace eosio { namespace chain {
    }
 
    void transaction_context::undo() {
+      table_cache.clear();
       if (undo_session) undo_session->undo();
    }
 
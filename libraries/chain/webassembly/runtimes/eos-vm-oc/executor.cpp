@@ -168,18 +168,29 @@ void executor::execute(const code_descriptor& code, memory& mem, apply_context&
    EOS_ASSERT(code.starting_memory_pages <= (int)max_pages, wasm_execution_error, "Initial memory out of range");
 
    //prepare initial memory, mutable globals, and table data
+   //linear memory backed by the memory slices is already zero, it is reset after every execution below
    if(code.starting_memory_pages > 0 ) {
       uint64_t initial_page_offset = std::min(static_cast<std::size_t>(code.starting_memory_pages), mem.size_of_memory_slice_mapping()/memory::stride - 1);
       if(initial_page_offset < static_cast<uint64_t>(code.starting_memory_pages)) {
-         mprotect(mem.full_page_memory_base() + initial_page_offset * eosio::chain::wasm_constraints::wasm_page_size,
-                  (code.starting_memory_pages - initial_page_offset) * eosio::chain::wasm_constraints::wasm_page_size, PROT_READ | PROT_WRITE);
+         uint8_t* const extended_memory_start = mem.full_page_memory_base() + initial_page_offset * eosio::chain::wasm_constraints::wasm_page_size;
+         const size_t extended_memory_size = (code.starting_memory_pages - initial_page_offset) * eosio::chain::wasm_constraints::wasm_page_size;
+         mprotect(extended_memory_start, extended_memory_size, PROT_READ | PROT_WRITE);
+         //memory beyond the slices is private anonymous memory, discarded pages read back as zero
+         madvise(extended_memory_start, extended_memory_size, MADV_DONTNEED);
       }
       arch_prctl(ARCH_SET_GS, (unsigned long*)(mem.zero_page_memory_base()+initial_page_offset*memory::stride));
-      memset(mem.full_page_memory_base(), 0, 64u*1024u*code.starting_memory_pages);
    }
    else
       arch_prctl(ARCH_SET_GS, (unsigned long*)mem.zero_page_memory_base());
 
+   //registered before initdata is copied so memory is left zeroed however execution ends. Only pages up to the
+   // high-water mark, which grow_memory raises, can have been written
+   control_block* const cb = mem.get_control_block();
+   cb->max_used_linear_memory_pages = std::max(code.starting_memory_pages, 0);
+   auto reset_memory = fc::make_scoped_exit([cb, &mem](){
+      mem.reset_sliced_memory(cb->max_used_linear_memory_pages);
+   });
+
    void* globals;
    if(code.initdata_prologue_size > memory::max_prologue_size) {
       globals_buffer.resize(code.initdata_prologue_size);
@@ -193,7 +204,6 @@ void executor::execute(const code_descriptor& code, memory& mem, apply_context&
       globals = mem.full_page_memory_base();
    }
 
-   control_block* const cb = mem.get_control_block();
    cb->magic = signal_sentinel;
    cb->execution_thread_code_start = (uintptr_t)code_mapping;
    cb->execution_thread_code_length = code_mapping_size;
@@ -42,6 +42,8 @@ int32_t eos_vm_oc_grow_memory(int32_t grow, int32_t max) {
    current_gs += gs_diff * EOS_VM_OC_MEMORY_STRIDE;
    arch_prctl(ARCH_SET_GS, (unsigned long*)current_gs);
    cb_ptr->current_linear_memory_pages += grow_amount;
+   if(cb_ptr->current_linear_memory_pages > cb_ptr->max_used_linear_memory_pages)
+      cb_ptr->max_used_linear_memory_pages = cb_ptr->current_linear_memory_pages;
    cb_ptr->first_invalid_memory_address += grow_amount*64*1024;
 
    if(grow_amount > 0)
@@ -5,6 +5,9 @@
 
 #include <fc/scoped_exit.hpp>
 
+#include <algorithm>
+
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/mman.h>
 
@@ -13,9 +16,11 @@ namespace eosio { namespace chain { namespace eosvmoc {
 memory::memory(uint64_t sliced_pages) {
    uint64_t number_slices = sliced_pages + 1;
    uint64_t wasm_memory_size = sliced_pages * wasm_constraints::wasm_page_size;
-   int fd = exec_sealed_memfd_create("eosvmoc_mem");
+   sliced_memory_size = wasm_memory_size;
+   fd = exec_sealed_memfd_create("eosvmoc_mem");
    FC_ASSERT(fd >= 0, "Failed to create memory memfd");
-   auto cleanup_fd = fc::make_scoped_exit([&fd](){close(fd);});
+   //kept open for reset_sliced_memory()
+   auto cleanup_fd = fc::make_scoped_exit([this](){close(fd);});
    int ret = ftruncate(fd, wasm_memory_size+memory_prologue_size);
    FC_ASSERT(!ret, "Failed to grow memory memfd");
 
@@ -41,10 +46,23 @@ memory::memory(uint64_t sliced_pages) {
    const intrinsic_map_t& intrinsics = get_intrinsic_map();
    for(const auto& intrinsic : intrinsics)
       intrinsic_jump_table[-(int)intrinsic.second.ordinal] = (uintptr_t)intrinsic.second.function_ptr;
+
+   cleanup_fd.cancel();
+}
+
+void memory::reset_sliced_memory(uint64_t used_pages) {
+   const uint64_t reset_size = std::min(used_pages * wasm_constraints::wasm_page_size, sliced_memory_size);
+   if(reset_size == 0)
+      return;
+   //all slices map the same memfd, so punching the linear memory out of the memfd zeroes it in every slice at once.
+   // MADV_DONTNEED would not do here since it does not discard the contents of shared mappings
+   if(fallocate(fd, FALLOC_FL_PUNCH_HOLE|FALLOC_FL_KEEP_SIZE, memory_prologue_size, reset_size))
+      memset(fullpage_base, 0, reset_size);
 }
 
 memory::~memory() {
    munmap(mapbase, mapsize);
+   close(fd);
 }
 
 }}}
@@ -30,6 +30,12 @@ class sha256
     static sha256 hash( const std::string& );
     static sha256 hash( const sha256& );
 
+    /**
+     * Hashes @p count independent messages of exactly 64 bytes each, stored back to back at @p d, into out[0..count).
+     * Uses the SHA extensions or hashes 8/16 messages at once with AVX2/AVX-512 when the cpu supports them.
+     */
+    static void hash_64_bytes_batch( const char* d, size_t count, sha256* out );
+
     template<typename T>
     static sha256 hash( const T& t ) 
     { 
@@ -5,6 +5,7 @@
 #include <ios>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include <boost/interprocess/file_mapping.hpp>
 
@@ -142,6 +143,35 @@ public:
       }
    }
 
+   /// Read n bytes at offset without using or moving the current file position. Only data already flushed
+   /// to the file is visible. Safe to call from multiple threads concurrently on the same cfile.
+   void read_at( char* d, size_t n, size_t offset ) const {
+      const int fd = fileno();
+      size_t total = 0;
+      while( total < n ) {
+         ssize_t result = ::pread( fd, d + total, n - total, offset + total );
+         if( result <= 0 ) {
+            if( result == -1 && errno == EINTR )
+               continue;
+            throw std::ios_base::failure( "cfile: " + _file_path.generic_string() +
+                                          " unable to read " + std::to_string( n ) + " bytes at " + std::to_string( offset ) +
+                                          "; only read " + std::to_string( total ) +
+                                          ", error: " + (result == 0 ? std::string("eof") : std::to_string( errno )) );
+         }
+         total += result;
+      }
+   }
+
+   /// size of the file on disk, does not include unflushed data
+   size_t filesize() const {
+      struct stat st;
+      if( -1 == fstat( fileno(), &st ) ) {
+         throw std::ios_base::failure( "cfile: " + _file_path.generic_string() +
+                                       " unable to stat file, error: " + std::to_string( errno ) );
+      }
+      return static_cast<size_t>(st.st_size);
+   }
+
    void write( const char* d, size_t n ) {
       size_t result = fwrite( d, 1, n, _file.get() );
       if( result != n ) {
@@ -0,0 +1,160 @@
+#pragma once
+#include <fc/io/json.hpp>
+#include <fc/reflect/reflect.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace fc
+{
+   /**
+    *  Opt-in for json_writer to write the members of a reflected type one by one. Only valid for types converted
+    *  to a variant by the reflected to_variant, i.e. which do not have their own to_variant. Use
+    *  FC_JSON_WRITE_REFLECTED to specialize.
+    */
+   template<typename T>
+   struct json_write_reflected : std::false_type {};
+
+   /**
+    *  Text which is already JSON, json_writer writes it as is
+    */
+   struct raw_json
+   {
+      std::string json;
+   };
+
+   /**
+    *  Writes JSON straight into a string.
+    *
+    *  The output is the same as json::to_string( variant(v) ), but fc::variant values, vectors, optionals and
+    *  json_write_reflected types are written as they are walked instead of first being converted to a variant
+    *  tree. Any other value is converted to a variant on its own and written.
+    */
+   class json_writer
+   {
+      public:
+         json_writer( std::string& out, const json::yield_function_t& yield,
+                      const json::output_formatting format = json::output_formatting::stringify_large_ints_and_doubles )
+         :out(out),yield(yield),format(format){}
+
+         void write( const variant& v );
+         void write( const variant_object& o );
+         void write( const variants& a );
+         void write( const raw_json& j ) { out.append( j.json ); }
+
+         /// writes s as a JSON string
+         void write_string( std::string_view s );
+         /// same as write( std::vector<char>( d, d + s ) ) without the copy
+         void write_hex( const char* d, size_t s );
+
+         template<typename T>
+         void write( const T& v );
+
+         /// writes "key":
+         void write_key( std::string_view key );
+         void put( char c ) { out.push_back( c ); }
+
+         size_t size()const { return out.size(); }
+
+      private:
+         template<typename T> struct is_optional : std::false_type {};
+         template<typename T> struct is_optional<std::optional<T>> : std::true_type {};
+         template<typename T> struct is_vector : std::false_type {};
+         template<typename T> struct is_vector<std::vector<T>> : std::negation<std::is_same<T, char>> {};
+
+         template<typename T>
+         class member_visitor
+         {
+            public:
+               member_visitor( json_writer& w, const T& v )
+               :w(w),val(v){}
+
+               template<typename Member, class Class, Member (Class::*member)>
+               void operator()( const char* name )const
+               {
+                  this->add( name, (val.*member) );
+               }
+
+            private:
+               // same as to_variant_visitor, empty optional members are left out
+               template<typename M>
+               void add( const char* name, const std::optional<M>& v )const
+               {
+                  if( v )
+                     add( name, *v );
+               }
+               template<typename M>
+               void add( const char* name, const M& v )const
+               {
+                  if( !first )
+                     w.put( ',' );
+                  first = false;
+                  w.write_key( name );
+                  w.write( v );
+               }
+
+               json_writer&  w;
+               const T&      val;
+               mutable bool  first = true;
+         };
+
+         std::string&                     out;
+         const json::yield_function_t&    yield;
+         const json::output_formatting    format;
+   };
+
+   template<typename T>
+   void json_writer::write( const T& v )
+   {
+      if constexpr( is_optional<T>::value ) {
+         if( v )
+            write( *v );
+         else
+            out += "null";
+      } else if constexpr( is_vector<T>::value ) {
+         if( v.size() > MAX_NUM_ARRAY_ELEMENTS ) throw std::range_error( "too large" );
+         yield( out.size() );
+         put( '[' );
+         for( size_t i = 0; i < v.size(); ++i ) {
+            if( i )
+               put( ',' );
+            write( v[i] );
+         }
+         put( ']' );
+      } else if constexpr( json_write_reflected<T>::value ) {
+         static_assert( !fc::reflector<T>::is_enum::value, "json_write_reflected is for reflected structs" );
+         yield( out.size() );
+         put( '{' );
+         fc::reflector<T>::visit( member_visitor<T>( *this, v ) );
+         put( '}' );
+      } else {
+         write( variant( v ) );
+      }
+   }
+
+   /**
+    *  Same result as json::to_string( variant(v), deadline, format, max_len ) without the intermediate variant
+    *  where json_writer can avoid it
+    */
+   template<typename T>
+   std::string to_json_string( const T& v, const fc::time_point& deadline = fc::time_point::maximum(),
+                               const json::output_formatting format = json::output_formatting::stringify_large_ints_and_doubles,
+                               const uint64_t max_len = json::max_length_limit )
+   {
+      const json::yield_function_t yield = [&](size_t s) {
+         FC_CHECK_DEADLINE(deadline);
+         FC_ASSERT( s <= max_len );
+      };
+      std::string out;
+      json_writer( out, yield, format ).write( v );
+      yield( out.size() );
+      return out;
+   }
+
+} // fc
+
+#define FC_JSON_WRITE_REFLECTED( TYPE ) \
+namespace fc { template<> struct json_write_reflected<TYPE> : std::true_type {}; }
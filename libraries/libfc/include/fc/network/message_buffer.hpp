@@ -325,7 +325,13 @@ namespace fc {
      explicit mb_peek_datastream( const message_buffer<buffer_len>& m )
      : mb( m ), index( m.read_index() ) {}
 
-     inline void skip( size_t s ) { message_buffer<buffer_len>::advance_index( index, s ); }
+     inline void skip( size_t s ) {
+        if( mb.bytes_to_read_from_index(index) < s ) {
+           fc::detail::throw_datastream_range_error( "skip",
+                 mb.bytes_to_read_from_index(index), s - mb.bytes_to_read_from_index(index) );
+        }
+        message_buffer<buffer_len>::advance_index( index, s );
+     }
 
      inline bool read( char* d, size_t s ) {
         if( mb.bytes_to_read_from_index(index) >= s ) {
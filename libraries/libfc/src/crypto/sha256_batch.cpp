@@ -0,0 +1,273 @@
+#include <fc/crypto/sha256.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+/*
+ * sha256 of a batch of independent 64 byte messages, as hashed by merkle trees where every message is a pair of
+ * digests. A 64 byte message is always exactly two compression blocks: the message itself and a padding block that
+ * only depends on the message length. The message schedule of the padding block is therefore precomputed once.
+ *
+ * The round function is written once as a template over the word type: uint32_t for the scalar fallback, or a gcc
+ * vector of 8 or 16 uint32_t that is instantiated inside functions compiled for AVX2 or AVX-512, hashing one message
+ * per lane. Single messages use the SHA extensions when available.
+ */
+
+namespace fc {
+
+namespace {
+
+constexpr uint32_t sha256_k[64] = {
+   0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+   0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+   0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+   0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+   0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+   0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+   0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+   0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+constexpr uint32_t sha256_initial_state[8] = {
+   0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+constexpr uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+// the padding block of a 64 byte message: a single 1 bit, zeros, and the message length of 512 bits
+alignas(16) constexpr uint8_t sha256_padding_block[64] = {
+   0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0
+};
+
+// round constants plus the expanded message schedule of the padding block
+struct padding_schedule_t {
+   uint32_t kw[64];
+   constexpr padding_schedule_t() : kw{} {
+      uint32_t w[64] = {};
+      w[0] = 0x80000000;
+      w[15] = 512;
+      for( int i = 16; i < 64; ++i ) {
+         uint32_t s0 = rotr(w[i-15], 7) ^ rotr(w[i-15], 18) ^ (w[i-15] >> 3);
+         uint32_t s1 = rotr(w[i-2], 17) ^ rotr(w[i-2], 19) ^ (w[i-2] >> 10);
+         w[i] = w[i-16] + s0 + w[i-7] + s1;
+      }
+      for( int i = 0; i < 64; ++i )
+         kw[i] = sha256_k[i] + w[i];
+   }
+};
+constexpr padding_schedule_t padding_schedule;
+
+inline uint32_t load_be32( const char* p ) {
+   uint32_t v;
+   memcpy( &v, p, sizeof(v) );
+   return __builtin_bswap32( v );
+}
+
+inline void store_be32( char* p, uint32_t v ) {
+   v = __builtin_bswap32( v );
+   memcpy( p, &v, sizeof(v) );
+}
+
+// the helpers below are always inlined into the functions compiled for the wider vector types
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+template<typename V>
+[[gnu::always_inline]] inline V rotr_lanes( const V& x, int n ) { return (x >> n) | (x << (32 - n)); }
+
+template<typename V>
+[[gnu::always_inline]] inline void sha256_round( V s[8], int i, const V& kw ) {
+   V& a = s[(64 - i) & 7];       // rotate register names instead of moving the state around
+   V& b = s[(65 - i) & 7];
+   V& c = s[(66 - i) & 7];
+   V& d = s[(67 - i) & 7];
+   V& e = s[(68 - i) & 7];
+   V& f = s[(69 - i) & 7];
+   V& g = s[(70 - i) & 7];
+   V& h = s[(71 - i) & 7];
+   V t1 = h + (rotr_lanes(e, 6) ^ rotr_lanes(e, 11) ^ rotr_lanes(e, 25)) + ((e & f) ^ (~e & g)) + kw;
+   V t2 = (rotr_lanes(a, 2) ^ rotr_lanes(a, 13) ^ rotr_lanes(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+   d += t1;
+   h = t1 + t2;
+}
+
+/// hashes one 64 byte message per lane of V; w holds word j of every lane's message in w[j]
+template<typename V>
+[[gnu::always_inline]] inline void sha256_64_bytes_lanes( V w[16], V state[8] ) {
+   V s[8];
+   for( int i = 0; i < 8; ++i )
+      s[i] = V{} + sha256_initial_state[i];
+
+   for( int i = 0; i < 64; ++i ) {
+      if( i >= 16 ) {
+         V w15 = w[(i + 1) & 15];
+         V w2  = w[(i + 14) & 15];
+         V s0  = rotr_lanes(w15, 7) ^ rotr_lanes(w15, 18) ^ (w15 >> 3);
+         V s1  = rotr_lanes(w2, 17) ^ rotr_lanes(w2, 19) ^ (w2 >> 10);
+         w[i & 15] += s0 + w[(i + 9) & 15] + s1;
+      }
+      sha256_round( s, i, w[i & 15] + sha256_k[i] );
+   }
+   for( int i = 0; i < 8; ++i )
+      state[i] = s[i] + sha256_initial_state[i];
+
+   for( int i = 0; i < 8; ++i )
+      s[i] = state[i];
+   for( int i = 0; i < 64; ++i )
+      sha256_round( s, i, V{} + padding_schedule.kw[i] );
+   for( int i = 0; i < 8; ++i )
+      state[i] += s[i];
+}
+
+template<typename V>
+[[gnu::always_inline]] inline void sha256_64_bytes_batch_lanes( const char* in, sha256* out ) {
+   constexpr size_t lanes = sizeof(V) / sizeof(uint32_t);
+
+   uint32_t words[16][lanes];
+   for( size_t j = 0; j < 16; ++j )
+      for( size_t l = 0; l < lanes; ++l )
+         words[j][l] = load_be32( in + l * 64 + j * 4 );
+
+   V w[16];
+   V state[8];
+   memcpy( w, words, sizeof(w) );
+   sha256_64_bytes_lanes( w, state );
+
+   uint32_t digests[8][lanes];
+   memcpy( digests, state, sizeof(digests) );
+   for( size_t i = 0; i < 8; ++i )
+      for( size_t l = 0; l < lanes; ++l )
+         store_be32( out[l].data() + i * 4, digests[i][l] );
+}
+
+void sha256_64_bytes_scalar( const char* in, sha256* out ) {
+   sha256_64_bytes_batch_lanes<uint32_t>( in, out );
+}
+
+#if defined(__x86_64__)
+
+typedef uint32_t u32x8  __attribute__((vector_size(32)));
+typedef uint32_t u32x16 __attribute__((vector_size(64)));
+
+__attribute__((target("avx2")))
+void sha256_64_bytes_avx2( const char* in, sha256* out ) {
+   sha256_64_bytes_batch_lanes<u32x8>( in, out );
+}
+
+__attribute__((target("avx512f")))
+void sha256_64_bytes_avx512( const char* in, sha256* out ) {
+   sha256_64_bytes_batch_lanes<u32x16>( in, out );
+}
+
+__attribute__((target("sha,sse4.1")))
+void sha256_compress_shani( __m128i& state0, __m128i& state1, const uint8_t* block ) {
+   const __m128i byte_swap = _mm_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+   const __m128i abef = state0;
+   const __m128i cdgh = state1;
+
+   // m[g % 4] holds message words 4g..4g+3 of the current group of four rounds
+   __m128i m[4];
+   for( int g = 0; g < 16; ++g ) {
+      if( g < 4 )
+         m[g] = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>(block + g * 16) ), byte_swap );
+      __m128i msg = _mm_add_epi32( m[g % 4], _mm_loadu_si128( reinterpret_cast<const __m128i*>(sha256_k + g * 4) ) );
+      state1 = _mm_sha256rnds2_epu32( state1, state0, msg );
+      if( g >= 3 && g < 15 ) {
+         __m128i& next = m[(g + 1) % 4];
+         next = _mm_add_epi32( next, _mm_alignr_epi8( m[g % 4], m[(g + 3) % 4], 4 ) );
+         next = _mm_sha256msg2_epu32( next, m[g % 4] );
+      }
+      msg = _mm_shuffle_epi32( msg, 0x0e );
+      state0 = _mm_sha256rnds2_epu32( state0, state1, msg );
+      if( g >= 1 && g < 13 )
+         m[(g + 3) % 4] = _mm_sha256msg1_epu32( m[(g + 3) % 4], m[g % 4] );
+   }
+
+   state0 = _mm_add_epi32( state0, abef );
+   state1 = _mm_add_epi32( state1, cdgh );
+}
+
+__attribute__((target("sha,sse4.1")))
+void sha256_64_bytes_shani( const char* in, sha256* out ) {
+   // the sha instructions keep the state as ABEF and CDGH
+   __m128i tmp    = _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>(sha256_initial_state) ), 0xb1 );
+   __m128i state1 = _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>(sha256_initial_state + 4) ), 0x1b );
+   __m128i state0 = _mm_alignr_epi8( tmp, state1, 8 );
+   state1 = _mm_blend_epi16( state1, tmp, 0xf0 );
+
+   sha256_compress_shani( state0, state1, reinterpret_cast<const uint8_t*>(in) );
+   sha256_compress_shani( state0, state1, sha256_padding_block );
+
+   tmp    = _mm_shuffle_epi32( state0, 0x1b );
+   state1 = _mm_shuffle_epi32( state1, 0xb1 );
+   state0 = _mm_blend_epi16( tmp, state1, 0xf0 );
+   state1 = _mm_alignr_epi8( state1, tmp, 8 );
+
+   const __m128i byte_swap = _mm_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+   _mm_storeu_si128( reinterpret_cast<__m128i*>(out->data()), _mm_shuffle_epi8( state0, byte_swap ) );
+   _mm_storeu_si128( reinterpret_cast<__m128i*>(out->data() + 16), _mm_shuffle_epi8( state1, byte_swap ) );
+}
+
+struct cpu_features {
+   bool sha    = false;
+   bool avx2   = false;
+   bool avx512 = false;
+
+   cpu_features() {
+      unsigned int eax, ebx, ecx, edx;
+      if( !__get_cpuid( 1, &eax, &ebx, &ecx, &edx ) )
+         return;
+      const bool ssse3_sse41 = (ecx & bit_SSSE3) && (ecx & bit_SSE4_1);
+      uint64_t xcr0 = 0;
+      if( ecx & bit_OSXSAVE ) {
+         uint32_t lo, hi;
+         __asm__( "xgetbv" : "=a"(lo), "=d"(hi) : "c"(0) );
+         xcr0 = (uint64_t(hi) << 32) | lo;
+      }
+      const bool os_avx    = (xcr0 & 0x06) == 0x06;   // xmm and ymm state
+      const bool os_avx512 = (xcr0 & 0xe6) == 0xe6;   // and opmask, zmm0-15 upper halves, zmm16-31
+
+      if( !__get_cpuid_count( 7, 0, &eax, &ebx, &ecx, &edx ) )
+         return;
+      sha    = ssse3_sse41 && (ebx & bit_SHA);
+      avx2   = os_avx && (ebx & bit_AVX2);
+      avx512 = os_avx512 && (ebx & bit_AVX512F);
+   }
+};
+
+#endif
+
+} // anonymous namespace
+
+void sha256::hash_64_bytes_batch( const char* d, size_t count, sha256* out ) {
+#if defined(__x86_64__)
+   static const cpu_features cpu;
+
+   // lanes are only worth filling when there are enough messages to fill them, the rest are hashed one at a time
+   if( cpu.avx512 ) {
+      for( ; count >= 16; count -= 16, d += 16 * 64, out += 16 )
+         sha256_64_bytes_avx512( d, out );
+   }
+   if( cpu.avx2 ) {
+      for( ; count >= 8; count -= 8, d += 8 * 64, out += 8 )
+         sha256_64_bytes_avx2( d, out );
+   }
+   if( cpu.sha ) {
+      for( ; count > 0; --count, d += 64, ++out )
+         sha256_64_bytes_shani( d, out );
+   }
+#endif
+   for( ; count > 0; --count, d += 64, ++out )
+      sha256_64_bytes_scalar( d, out );
+}
+
+} //end namespace fc
@@ -1,4 +1,5 @@
 #include <fc/io/json.hpp>
+#include <fc/io/json_writer.hpp>
 //#include <fc/io/fstream.hpp>
 //#include <fc/io/sstream.hpp>
 #include <fc/log/logger.hpp>
@@ -647,12 +648,81 @@ namespace fc
       }
    }
 
+   namespace {
+      /// the part of std::ostream used by to_stream, appending to a std::string
+      class string_sink
+      {
+         public:
+            explicit string_sink( std::string& out ) : out(out) {}
+
+            size_t tellp()const { return out.size(); }
+
+            string_sink& operator<<( char c )               { out.push_back( c ); return *this; }
+            string_sink& operator<<( const char* s )        { out.append( s ); return *this; }
+            string_sink& operator<<( const std::string& s ) { out.append( s ); return *this; }
+            string_sink& operator<<( int64_t i )            { out.append( std::to_string( i ) ); return *this; }
+            string_sink& operator<<( uint64_t i )           { out.append( std::to_string( i ) ); return *this; }
+
+         private:
+            std::string& out;
+      };
+   }
+
+   void json_writer::write( const variant& v )
+   {
+      string_sink os( out );
+      fc::to_stream( os, v, yield, format );
+   }
+
+   void json_writer::write( const variant_object& o )
+   {
+      string_sink os( out );
+      fc::to_stream( os, o, yield, format );
+   }
+
+   void json_writer::write( const variants& a )
+   {
+      string_sink os( out );
+      fc::to_stream( os, a, yield, format );
+   }
+
+   void json_writer::write_string( std::string_view s )
+   {
+      yield( out.size() );
+      out.push_back( '"' );
+      out.append( escape_string( s, yield ) );
+      out.push_back( '"' );
+   }
+
+   void json_writer::write_hex( const char* d, size_t s )
+   {
+      FC_ASSERT( s <= MAX_SIZE_OF_BYTE_ARRAYS );
+      yield( out.size() );
+      constexpr char hex[] = "0123456789abcdef";
+      const auto* c = reinterpret_cast<const uint8_t*>( d );
+      size_t pos = out.size();
+      out.resize( pos + 2 * s + 2 );
+      out[pos++] = '"';
+      for( size_t i = 0; i < s; ++i ) {
+         out[pos++] = hex[c[i] >> 4];
+         out[pos++] = hex[c[i] & 0x0f];
+      }
+      out[pos] = '"';
+   }
+
+   void json_writer::write_key( std::string_view key )
+   {
+      out.push_back( '"' );
+      out.append( escape_string( key, yield ) );
+      out.append( "\":" );
+   }
+
    std::string   json::to_string( const variant& v, const json::yield_function_t& yield, const json::output_formatting format )
    {
-      std::stringstream ss;
-      fc::to_stream( ss, v, yield, format );
-      yield(ss.tellp());
-      return ss.str();
+      std::string out;
+      json_writer( out, yield, format ).write( v );
+      yield(out.size());
+      return out;
    }
 
    std::string pretty_print( const std::string& v, const uint8_t indent ) {
@@ -1,6 +1,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <fc/crypto/hex.hpp>
+#include <fc/crypto/sha256.hpp>
 #include <fc/crypto/sha3.hpp>
 #include <fc/utility.hpp>
 
@@ -66,4 +67,22 @@ BOOST_AUTO_TEST_CASE(keccak256) try {
 
 } FC_LOG_AND_RETHROW();
 
+BOOST_AUTO_TEST_CASE(sha256_64_bytes_batch) try {
+
+   // enough messages to go through every lane width plus a tail hashed one at a time
+   for(size_t count = 0; count <= 41; ++count) {
+      std::vector<char> messages(count * 64);
+      for(size_t i = 0; i < messages.size(); ++i)
+         messages[i] = static_cast<char>(i * 131 + count);
+
+      std::vector<fc::sha256> digests(count);
+      fc::sha256::hash_64_bytes_batch(messages.data(), count, digests.data());
+
+      for(size_t i = 0; i < count; ++i) {
+         BOOST_CHECK_EQUAL(digests[i].str(), fc::sha256::hash(messages.data() + i * 64, 64).str());
+      }
+   }
+
+} FC_LOG_AND_RETHROW();
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
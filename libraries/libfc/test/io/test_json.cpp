@@ -1,10 +1,35 @@
 #include <boost/test/unit_test.hpp>
 
 #include <fc/io/json.hpp>
+#include <fc/io/json_writer.hpp>
 #include <fc/exception/exception.hpp>
+#include <fc/reflect/variant.hpp>
 
 using namespace fc;
 
+namespace json_writer_test {
+   struct row {
+      std::string name;
+      uint64_t    amount = 0;
+      int32_t     delta  = 0;
+   };
+
+   struct result {
+      std::vector<fc::variant> rows;
+      std::vector<row>         reflected_rows;
+      std::optional<row>       first;
+      std::optional<row>       missing;
+      std::vector<char>        data;
+      fc::time_point           when;
+      bool                     more = false;
+   };
+}
+
+FC_REFLECT(json_writer_test::row, (name)(amount)(delta))
+FC_REFLECT(json_writer_test::result, (rows)(reflected_rows)(first)(missing)(data)(when)(more))
+FC_JSON_WRITE_REFLECTED(json_writer_test::row)
+FC_JSON_WRITE_REFLECTED(json_writer_test::result)
+
 BOOST_AUTO_TEST_SUITE(json_test_suite)
 
 namespace json_test_util {
@@ -242,4 +267,48 @@ BOOST_AUTO_TEST_CASE(escape_string_test)
    }
 }
 
+BOOST_AUTO_TEST_CASE(json_writer_same_as_to_string_test)
+{
+   json_writer_test::result r;
+   r.rows.emplace_back(mutable_variant_object("key\n", "value \"quoted\"")("big", uint64_t(1) << 40)("small", -7));
+   r.rows.emplace_back(variants{variant(1.5), variant(), variant(true)});
+   r.reflected_rows = {{"a", 1, -1}, {json_test_util::escape_input_str, uint64_t(1) << 33, 5}};
+   r.first          = json_writer_test::row{"first", 2, 3};
+   r.data           = {'\x01', 'a'};
+   r.when           = fc::time_point(fc::seconds(1));
+   r.more           = true;
+
+   for (auto format : {json::output_formatting::stringify_large_ints_and_doubles, json::output_formatting::legacy_generator}) {
+      BOOST_CHECK_EQUAL(to_json_string(r, fc::time_point::maximum(), format),
+                        json::to_string(variant(r), fc::time_point::maximum(), format));
+   }
+
+   BOOST_CHECK_EXCEPTION(to_json_string(r, fc::time_point::min()), fc::timeout_exception, json_test_util::time_except_verf_func);
+   BOOST_CHECK_EXCEPTION(to_json_string(r, fc::time_point::maximum(), json::output_formatting::stringify_large_ints_and_doubles,
+                                        json_test_util::exception_limit_size),
+                         fc::assert_exception, json_test_util::length_limit_except_verf_func);
+}
+
+BOOST_AUTO_TEST_CASE(json_writer_hex_and_raw_test)
+{
+   const std::vector<char> data = {'\x00', '\x7f', '\x80', '\xff', 'a'};
+   const json::yield_function_t yield = [](size_t) {};
+
+   std::string out;
+   json_writer w(out, yield);
+   w.put('[');
+   w.write_hex(data.data(), data.size());
+   w.put(',');
+   w.write_hex(nullptr, 0);
+   w.put(',');
+   w.write_string(json_test_util::escape_input_str);
+   w.put(',');
+   w.write(raw_json{"{\"a\":1}"});
+   w.put(']');
+
+   variants expected{variant(data), variant(std::vector<char>{}), variant(json_test_util::escape_input_str)};
+   const auto expected_str = json::to_string(variant(expected), fc::time_point::maximum());
+   BOOST_CHECK_EQUAL(out, expected_str.substr(0, expected_str.size() - 1) + ",{\"a\":1}]");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,9 +1,14 @@
 #include <eosio/state_history/compression.hpp>
+#include <eosio/chain/exceptions.hpp>
 
 #include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/filter/zlib.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
+#include <fc/io/fstream.hpp>
+
+#include <zstd.h>
+
 namespace eosio {
 namespace state_history {
 
@@ -28,7 +33,111 @@ bytes zlib_decompress(std::string_view data) {
    return out;
 }
 
+bytes zstd_decompress(std::string_view data, std::shared_ptr<const zstd_dictionary> dict) {
+   bytes                  out;
+   bio::filtering_ostream decomp;
+   decomp.push(zstd_decompressor(std::move(dict)));
+   decomp.push(bio::back_inserter(out));
+   bio::write(decomp, data.data(), data.size());
+   bio::close(decomp);
+   return out;
+}
+
+compression_type to_compression_type(const std::string& name) {
+   if (name == "zlib")
+      return compression_type::zlib;
+   if (name == "zstd")
+      return compression_type::zstd;
+   EOS_THROW(chain::plugin_config_exception, "unknown state history compression ${n}, expected zlib or zstd", ("n", name));
+}
+
+static size_t check_zstd(size_t r, const char* what) {
+   EOS_ASSERT(!ZSTD_isError(r), chain::plugin_exception, "zstd ${what} failed: ${e}", ("what", what)("e", ZSTD_getErrorName(r)));
+   return r;
+}
+
+zstd_dictionary::zstd_dictionary(const std::vector<char>& dict, int compression_level)
+   : _cdict(ZSTD_createCDict(dict.data(), dict.size(), compression_level))
+   , _ddict(ZSTD_createDDict(dict.data(), dict.size())) {
+   if (!_cdict || !_ddict) {
+      ZSTD_freeCDict(_cdict);
+      ZSTD_freeDDict(_ddict);
+      EOS_THROW(chain::plugin_exception, "unable to load zstd dictionary");
+   }
+}
+
+zstd_dictionary::~zstd_dictionary() {
+   ZSTD_freeCDict(_cdict);
+   ZSTD_freeDDict(_ddict);
+}
+
+std::shared_ptr<const zstd_dictionary> zstd_dictionary::load(const std::filesystem::path& file, int compression_level) {
+   if (!std::filesystem::exists(file))
+      return {};
+   std::string dict;
+   fc::read_file_contents(file, dict);
+   EOS_ASSERT(!dict.empty(), chain::plugin_exception, "zstd dictionary ${f} is empty", ("f", file));
+   return std::make_shared<zstd_dictionary>(std::vector<char>(dict.begin(), dict.end()), compression_level);
+}
+
+namespace detail {
+
+zstd_compressor_impl::zstd_compressor_impl(int compression_level, std::shared_ptr<const zstd_dictionary> d)
+   : ctx(ZSTD_createCCtx())
+   , dict(std::move(d)) {
+   EOS_ASSERT(ctx, chain::plugin_exception, "unable to create zstd compression context");
+   // a digested dictionary carries its own compression level
+   if (dict)
+      check_zstd(ZSTD_CCtx_refCDict(ctx, dict->cdict()), "dictionary");
+   else
+      check_zstd(ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, compression_level), "compression level");
+}
+
+zstd_compressor_impl::~zstd_compressor_impl() { ZSTD_freeCCtx(ctx); }
+
+bool zstd_compressor_impl::filter(const char*& src_begin, const char* src_end, char*& dest_begin, char* dest_end,
+                                  bool flush) {
+   ZSTD_inBuffer  in{src_begin, static_cast<size_t>(src_end - src_begin), 0};
+   ZSTD_outBuffer out{dest_begin, static_cast<size_t>(dest_end - dest_begin), 0};
+   size_t remaining = check_zstd(ZSTD_compressStream2(ctx, &out, &in, flush ? ZSTD_e_end : ZSTD_e_continue), "compress");
+   src_begin += in.pos;
+   dest_begin += out.pos;
+   // when flushing, 0 means the frame is complete
+   return !flush || remaining != 0;
+}
+
+void zstd_compressor_impl::close() { ZSTD_CCtx_reset(ctx, ZSTD_reset_session_only); }
+
+zstd_decompressor_impl::zstd_decompressor_impl(std::shared_ptr<const zstd_dictionary> d)
+   : ctx(ZSTD_createDCtx())
+   , dict(std::move(d)) {
+   EOS_ASSERT(ctx, chain::plugin_exception, "unable to create zstd decompression context");
+   if (dict)
+      check_zstd(ZSTD_DCtx_refDDict(ctx, dict->ddict()), "dictionary");
+}
+
+zstd_decompressor_impl::~zstd_decompressor_impl() { ZSTD_freeDCtx(ctx); }
+
+bool zstd_decompressor_impl::filter(const char*& src_begin, const char* src_end, char*& dest_begin, char* dest_end,
+                                    bool flush) {
+   if (eof)
+      return false;
+   ZSTD_inBuffer  in{src_begin, static_cast<size_t>(src_end - src_begin), 0};
+   ZSTD_outBuffer out{dest_begin, static_cast<size_t>(dest_end - dest_begin), 0};
+   size_t hint = check_zstd(ZSTD_decompressStream(ctx, &out, &in), "decompress");
+   src_begin += in.pos;
+   dest_begin += out.pos;
+   eof = hint == 0;
+   EOS_ASSERT(eof || !flush || in.pos || out.pos, chain::plugin_exception, "truncated zstd stream");
+   return !eof;
+}
+
+void zstd_decompressor_impl::close() {
+   ZSTD_DCtx_reset(ctx, ZSTD_reset_session_only);
+   eof = false;
+}
 
+} // namespace detail
 
 } // namespace state_history
 } // namespace eosio
@@ -2,6 +2,16 @@
 
 #include <eosio/chain/types.hpp>
 
+#include <boost/iostreams/filter/symmetric.hpp>
+
+#include <filesystem>
+#include <memory>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace eosio {
 namespace state_history {
 
@@ -10,5 +20,89 @@ using chain::bytes;
 bytes zlib_compress_bytes(const bytes& in);
 bytes zlib_decompress(std::string_view);
 
+enum class compression_type { zlib, zstd };
+
+compression_type to_compression_type(const std::string& name);
+
+/// A zstd dictionary (e.g. trained with `zstd --train`) digested once for compression and decompression and
+/// shared by every stream using it
+class zstd_dictionary {
+ public:
+   zstd_dictionary(const std::vector<char>& dict, int compression_level);
+   ~zstd_dictionary();
+
+   zstd_dictionary(const zstd_dictionary&) = delete;
+   zstd_dictionary& operator=(const zstd_dictionary&) = delete;
+
+   /// @return the dictionary in file, or nullptr if the file does not exist
+   static std::shared_ptr<const zstd_dictionary> load(const std::filesystem::path& file, int compression_level);
+
+   ZSTD_CDict_s* cdict() const { return _cdict; }
+   ZSTD_DDict_s* ddict() const { return _ddict; }
+
+ private:
+   ZSTD_CDict_s* _cdict = nullptr;
+   ZSTD_DDict_s* _ddict = nullptr;
+};
+
+namespace detail {
+
+// Impl of boost::iostreams::symmetric_filter, each compressed stream is a single zstd frame
+class zstd_compressor_impl {
+ public:
+   typedef char char_type;
+
+   zstd_compressor_impl(int compression_level, std::shared_ptr<const zstd_dictionary> dict);
+   ~zstd_compressor_impl();
+
+   bool filter(const char*& src_begin, const char* src_end, char*& dest_begin, char* dest_end, bool flush);
+   void close();
+
+ private:
+   ZSTD_CCtx_s*                           ctx = nullptr;
+   std::shared_ptr<const zstd_dictionary> dict;
+};
+
+class zstd_decompressor_impl {
+ public:
+   typedef char char_type;
+
+   explicit zstd_decompressor_impl(std::shared_ptr<const zstd_dictionary> dict);
+   ~zstd_decompressor_impl();
+
+   bool filter(const char*& src_begin, const char* src_end, char*& dest_begin, char* dest_end, bool flush);
+   void close();
+
+ private:
+   ZSTD_DCtx_s*                           ctx = nullptr;
+   std::shared_ptr<const zstd_dictionary> dict;
+   bool                                   eof = false;
+};
+
+} // namespace detail
+
+/// zstd counterpart of boost::iostreams::zlib_compressor
+struct zstd_compressor : boost::iostreams::symmetric_filter<detail::zstd_compressor_impl> {
+   typedef boost::iostreams::symmetric_filter<detail::zstd_compressor_impl> base_type;
+
+   static constexpr int default_compression_level = 3;
+
+   explicit zstd_compressor(int compression_level = default_compression_level,
+                            std::shared_ptr<const zstd_dictionary> dict = {},
+                            std::streamsize buffer_size = boost::iostreams::default_device_buffer_size)
+      : base_type(buffer_size, compression_level, std::move(dict)) {}
+};
+
+/// zstd counterpart of boost::iostreams::zlib_decompressor
+struct zstd_decompressor : boost::iostreams::symmetric_filter<detail::zstd_decompressor_impl> {
+   typedef boost::iostreams::symmetric_filter<detail::zstd_decompressor_impl> base_type;
+
+   explicit zstd_decompressor(std::shared_ptr<const zstd_dictionary> dict = {},
+                              std::streamsize buffer_size = boost::iostreams::default_device_buffer_size)
+      : base_type(buffer_size, std::move(dict)) {}
+};
+
+bytes zstd_decompress(std::string_view, std::shared_ptr<const zstd_dictionary> dict = {});
+
 } // namespace state_history
 } // namespace eosio
@@ -20,7 +20,10 @@
 #include <boost/iostreams/filtering_streambuf.hpp>
 #include <boost/iostreams/restrict.hpp>
 
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <cstdint>
 
 
@@ -50,6 +53,9 @@ namespace bio = boost::iostreams;
  * The end of the log has a 4 byte value that indicates guaranteed number of blocks the log has at its
  *  end (this can be used to reconstruct an index of the log from the end even when there is a hole in
  *  the middle of the log)
+ *
+ * Entries compressed with zstd instead of zlib have the zstd feature set in their own header, so a log may
+ *  contain a mix of both. When a zstd dictionary is configured, it is required to read those entries back.
  */
 
 inline uint64_t       ship_magic(uint16_t version, uint16_t features = 0) {
@@ -65,8 +71,11 @@ inline uint16_t       get_ship_features(uint64_t magic) { return magic>>16; }
 inline bool           is_ship_supported_version(uint64_t magic) { return get_ship_version(magic) == 0; }
 static const uint16_t ship_current_version = 0;
 static const uint16_t ship_feature_pruned_log = 1;
+static const uint16_t ship_feature_zstd = 2;
 inline bool           is_ship_log_pruned(uint64_t magic) { return get_ship_features(magic) & ship_feature_pruned_log; }
+inline uint64_t       set_ship_log_pruned_feature(uint64_t magic) { return ship_magic(get_ship_version(magic), get_ship_features(magic) | ship_feature_pruned_log); }
 inline uint64_t       clear_ship_log_pruned_feature(uint64_t magic) { return ship_magic(get_ship_version(magic), get_ship_features(magic) & ~ship_feature_pruned_log); }
+inline bool           is_ship_entry_zstd(uint64_t magic) { return get_ship_features(magic) & ship_feature_zstd; }
 
 struct state_history_log_header {
    uint64_t             magic        = ship_magic(ship_current_version);
@@ -91,32 +100,91 @@ namespace state_history {
       uint32_t              stride             = 1000000;
       uint32_t              max_retained_files = UINT32_MAX;
    };
+
+   struct compression_config {
+      compression_type      type               = compression_type::zlib;
+      int                   zstd_level         = zstd_compressor::default_compression_level;
+   };
 } // namespace state_history
 
 using state_history_log_config = std::variant<std::monostate, state_history::prune_config, state_history::partition_config>;
 
+namespace detail {
+
+/// Shared read access to the entries of a state_history_log, Lockable so it can be held with std::unique_lock.
+/// Any number of readers may hold it at once. Appending to the log does not wait for readers; a writer about to
+/// truncate calls wait_for_readers(), and new readers are held off while it waits. A prune only runs when try_rewrite()
+/// finds no readers.
+class log_readers {
+ public:
+   explicit log_readers(std::mutex& mx)
+   : mx(mx) {}
+
+   void lock() {
+      std::unique_lock g(mx);
+      cv.wait(g, [this]() { return !rewrite_pending; });
+      ++count;
+   }
+
+   bool try_lock() {
+      std::lock_guard g(mx);
+      if (rewrite_pending)
+         return false;
+      ++count;
+      return true;
+   }
+
+   void unlock() {
+      {
+         std::lock_guard g(mx);
+         --count;
+      }
+      cv.notify_all();
+   }
+
+   /// mx must be held by the caller, it is released while waiting so the log must be in a consistent state
+   void wait_for_readers() {
+      rewrite_pending = true;
+      cv.wait(mx, [this]() { return count == 0; });
+      rewrite_pending = false;
+      cv.notify_all();
+   }
+
+   /// mx must be held by the caller, readers cannot be added until it is released
+   /// @return true if no reader holds the log, for a rewrite that does not wait for readers
+   bool try_rewrite() const { return count == 0; }
+
+ private:
+   std::mutex&                 mx;
+   std::condition_variable_any cv;
+   uint32_t                    count = 0;
+   bool                        rewrite_pending = false;
+};
+
+} // namespace detail
+
 struct locked_decompress_stream {
-   std::unique_lock<std::mutex> lock; // state_history_log mutex
+   std::unique_lock<detail::log_readers> lock; // shared read access to the state_history_log
+   std::shared_ptr<const state_history::zstd_dictionary> zstd_dict; // of the state_history_log, if it has one
    std::variant<std::vector<char>, std::unique_ptr<bio::filtering_istreambuf>> buf;
 
    locked_decompress_stream() = delete;
    locked_decompress_stream(locked_decompress_stream&&) = default;
 
-   explicit locked_decompress_stream(std::unique_lock<std::mutex> l)
-   : lock(std::move(l)) {};
+   explicit locked_decompress_stream(std::unique_lock<detail::log_readers> l,
+                                     std::shared_ptr<const state_history::zstd_dictionary> dict = {})
+   : lock(std::move(l)), zstd_dict(std::move(dict)) {};
 
    template <typename StateHistoryLog>
-   void init(StateHistoryLog&& log, fc::cfile& stream, uint64_t compressed_size) {
-      auto istream = std::make_unique<bio::filtering_istreambuf>();
-      istream->push(bio::zlib_decompressor());
+   void init(StateHistoryLog&& log, fc::cfile& stream, uint64_t compressed_size, bool zstd) {
+      auto istream = make_istream(zstd);
       istream->push(bio::restrict(bio::file_source(stream.get_file_path().string()), stream.tellp(), compressed_size));
       buf = std::move(istream);
    }
 
    template <typename LogData>
-   void init(LogData&& log, fc::datastream<const char*>& stream, uint64_t compressed_size) {
-      auto istream = std::make_unique<bio::filtering_istreambuf>();
-      istream->push(bio::zlib_decompressor());
+   void init(LogData&& log, fc::datastream<const char*>& stream, uint64_t compressed_size, bool zstd) {
+      auto istream = make_istream(zstd);
       istream->push(bio::restrict(bio::file_source(log.filename), stream.pos() - log.data(), compressed_size));
       buf = std::move(istream);
    }
@@ -125,6 +193,16 @@ struct locked_decompress_stream {
       buf.emplace<std::vector<char>>( std::move(cbuf) );
       return std::get<std::vector<char>>(buf).size();
    }
+
+ private:
+   std::unique_ptr<bio::filtering_istreambuf> make_istream(bool zstd) const {
+      auto istream = std::make_unique<bio::filtering_istreambuf>();
+      if (zstd)
+         istream->push(state_history::zstd_decompressor(zstd_dict));
+      else
+         istream->push(bio::zlib_decompressor());
+      return istream;
+   }
 };
 
 namespace detail {
@@ -146,18 +224,23 @@ inline std::vector<char> zlib_decompress(fc::datastream<const char*>& strm, uint
 }
 
 template <typename Log, typename Stream>
-uint64_t read_unpacked_entry(Log&& log, Stream& stream, uint64_t payload_size, locked_decompress_stream& result) {
-   // result has state_history_log mutex locked
+uint64_t read_unpacked_entry(Log&& log, Stream& stream, const state_history_log_header& header, locked_decompress_stream& result) {
+   // result has shared read access to the state_history_log and the caller holds its mutex
 
+   const uint64_t payload_size = header.payload_size;
+   const bool     zstd         = is_ship_entry_zstd(header.magic);
    uint32_t s;
    stream.read((char*)&s, sizeof(s));
    if (s == 1 && payload_size > (s + sizeof(uint32_t))) {
       uint64_t compressed_size = payload_size - sizeof(uint32_t) - sizeof(uint64_t);
       uint64_t decompressed_size;
       stream.read((char*)&decompressed_size, sizeof(decompressed_size));
-      result.init(log, stream, compressed_size);
+      result.init(log, stream, compressed_size, zstd);
       return decompressed_size;
    } else {
+      EOS_ASSERT(!zstd, chain::plugin_exception, "corrupt state history entry for block ${b}: zstd entry without size prefix",
+                 ("b", chain::block_header::num_from_id(header.block_id)));
+
       // Compressed deltas now exceeds 4GB on one of the public chains. This length prefix
       // was intended to support adding additional fields in the future after the
       // packed deltas or packed traces. For now we're going to ignore on read.
@@ -196,10 +279,10 @@ class state_history_log_data : public chain::log_data_base<state_history_log_dat
    bool is_currently_pruned() const { return is_currently_pruned_; }
 
    uint64_t ro_stream_at(uint64_t pos, locked_decompress_stream& result) {
-      uint64_t                    payload_size = payload_size_at(pos);
+      state_history_log_header    header = header_at(pos);
       file.seek(pos + sizeof(state_history_log_header));
       // fc::datastream<const char*> stream(file.const_data() + pos + sizeof(state_history_log_header), payload_size);
-      return read_unpacked_entry(*this, file, payload_size, result);
+      return read_unpacked_entry(*this, file, header, result);
    }
 
    uint32_t block_num_at(uint64_t position) {
@@ -212,7 +295,9 @@ class state_history_log_data : public chain::log_data_base<state_history_log_dat
                                                       offsetof(state_history_log_header, block_id));
    }
 
-   uint64_t payload_size_at(uint64_t pos) {
+   uint64_t payload_size_at(uint64_t pos) { return header_at(pos).payload_size; }
+
+   state_history_log_header header_at(uint64_t pos) {
       std::string filename = file.get_file_path().generic_string();
       EOS_ASSERT(size() >= pos + sizeof(state_history_log_header), chain::plugin_exception,
                  "corrupt ${name}: invalid entry size at at position ${pos}", ("name", filename)("pos", pos));
@@ -224,7 +309,7 @@ class state_history_log_data : public chain::log_data_base<state_history_log_dat
 
       EOS_ASSERT(size() >= pos + sizeof(state_history_log_header) + header.payload_size, chain::plugin_exception,
                  "corrupt ${name}: invalid payload size for entry at position ${pos}", ("name", filename)("pos", pos));
-      return header.payload_size;
+      return header;
    }
 
    void construct_index(const std::filesystem::path& index_file_name) {
@@ -284,15 +369,20 @@ class state_history_log {
  private:
    const char* const       name = "";
    state_history_log_config _config;
+   state_history::compression_config _compression;
+   std::shared_ptr<const state_history::zstd_dictionary> _zstd_dict; // loaded from <name>.zdict when present
 
    // provide exclusive access to all data of this object since accessed from the main thread and the ship thread
    mutable std::mutex      _mx;
+   // readers streaming entries out of the log, only held by locked_decompress_stream
+   detail::log_readers     _readers{_mx};
    fc::cfile               log;
    fc::cfile               index;
    uint32_t                _begin_block = 0;        //always tracks the first block available even after pruning
    uint32_t                _index_begin_block = 0;  //the first block of the file; even after pruning. it's what index 0 in the index file points to
    uint32_t                _end_block   = 0;
    chain::block_id_type    last_block_id;
+   bool                    _prune_pending = false;  //prune deferred because readers were streaming from the log
 
    using catalog_t = chain::log_catalog<detail::state_history_log_data, chain::log_index<chain::plugin_exception>>;
    catalog_t catalog;
@@ -303,13 +393,19 @@ class state_history_log {
    state_history_log( const state_history_log&) = delete;
 
    state_history_log(const char* name, const std::filesystem::path& log_dir,
-                     state_history_log_config conf = {})
+                     state_history_log_config conf = {}, state_history::compression_config compression = {})
        : name(name)
-       , _config(std::move(conf)) {
+       , _config(std::move(conf))
+       , _compression(compression) {
 
       log.set_file_path(log_dir/(std::string(name) + ".log"));
       index.set_file_path(log_dir/(std::string(name) + ".index"));
 
+      // loaded even when writing zlib since earlier entries may have been written with zstd
+      _zstd_dict = state_history::zstd_dictionary::load(log_dir/(std::string(name) + ".zdict"), _compression.zstd_level);
+      if (_zstd_dict)
+         ilog("${name}.log using zstd dictionary ${name}.zdict", ("name", name));
+
       open_log();
       open_index();
 
@@ -343,7 +439,7 @@ class state_history_log {
 
             //update first header to indicate prune feature is enabled
             log.seek(0);
-            first_header.magic = ship_magic(get_ship_version(first_header.magic), ship_feature_pruned_log);
+            first_header.magic = set_ship_log_pruned_feature(first_header.magic);
             write_header(first_header);
 
             //write trailer on log with num blocks
@@ -376,6 +472,10 @@ class state_history_log {
       return _config;
    }
 
+   const state_history::compression_config& compression() const {
+      return _compression;
+   }
+
    //        begin     end
    std::pair<uint32_t, uint32_t> block_range() const {
       std::lock_guard g(_mx);
@@ -387,14 +487,22 @@ class state_history_log {
       return r.first == r.second;
    }
 
+   /// Blocks while the log is truncating or pruning. Streams read entries through their own file handles, so
+   /// any number of them can be in use at once, but the log does not rewrite entries until all are destroyed.
    locked_decompress_stream create_locked_decompress_stream() {
-      return locked_decompress_stream{ std::unique_lock<std::mutex>( _mx ) };
+      return locked_decompress_stream{ std::unique_lock<detail::log_readers>( _readers ), _zstd_dict };
+   }
+
+   /// Does not block, the returned stream does not own its lock if the log is waiting to truncate
+   locked_decompress_stream create_locked_decompress_stream(std::try_to_lock_t) {
+      return locked_decompress_stream{ std::unique_lock<detail::log_readers>( _readers, std::try_to_lock ), _zstd_dict };
    }
 
    /// @return the decompressed entry size
    uint64_t get_unpacked_entry(uint32_t block_num, locked_decompress_stream& result) {
-
-      // result has mx locked
+      EOS_ASSERT(result.lock.owns_lock(), chain::plugin_exception, "reading ${name}.log requires a locked stream", ("name", name));
+      // only held to locate the entry, result keeps its data from being rewritten while it is streamed
+      std::lock_guard g(_mx);
 
       auto opt_decompressed_size = catalog.ro_stream_for_block(block_num, result);
       if (opt_decompressed_size)
@@ -407,12 +515,15 @@ class state_history_log {
       log.seek(get_pos(block_num));
       read_header(header);
 
-      return detail::read_unpacked_entry(*this, log, header.payload_size, result);
+      return detail::read_unpacked_entry(*this, log, header, result);
    }
 
    template <typename F>
    void pack_and_write_entry(state_history_log_header header, const chain::block_id_type& prev_id, F&& pack_to) {
       std::lock_guard g(_mx);
+      const bool zstd = _compression.type == state_history::compression_type::zstd;
+      if (zstd)
+         header.magic = ship_magic(get_ship_version(header.magic), get_ship_features(header.magic) | ship_feature_zstd);
       write_entry(header, prev_id, [&, pack_to = std::forward<F>(pack_to)](auto& stream) {
          size_t payload_pos = stream.tellp();
 
@@ -434,7 +545,10 @@ class state_history_log {
          {
             bio::filtering_ostreambuf buf;
             buf.push(boost::ref(cnt));
-            buf.push(bio::zlib_compressor());
+            if (zstd)
+               buf.push(state_history::zstd_compressor(_compression.zstd_level, _zstd_dict));
+            else
+               buf.push(bio::zlib_compressor());
             buf.push(bio::file_descriptor_sink(stream.fileno(), bio::never_close_handle));
             pack_to(buf);
          }
@@ -528,7 +642,7 @@ class state_history_log {
 
       //if we're operating on a pruned block log and this is the first entry in the log, make note of the feature in the header
       if(prune_config && _begin_block == _end_block)
-         header.magic = ship_magic(get_ship_version(header.magic), ship_feature_pruned_log);
+         header.magic = set_ship_log_pruned_feature(header.magic);
 
       uint64_t pos = log.tellp();
 
@@ -547,9 +661,9 @@ class state_history_log {
       _end_block    = block_num + 1;
       last_block_id = header.block_id;
 
+      bool prune_needed = false;
       if(prune_config) {
-         if((pos&prune_config->prune_threshold) != (log.tellp()&prune_config->prune_threshold))
-            prune(fc::log_level::debug);
+         prune_needed = _prune_pending || (pos&prune_config->prune_threshold) != (log.tellp()&prune_config->prune_threshold);
 
          const uint32_t num_blocks_in_log = _end_block - _begin_block;
          fc::raw::pack(log, num_blocks_in_log);
@@ -558,6 +672,14 @@ class state_history_log {
       log.flush();
       index.flush();
 
+      // prune only once the entry is completely written
+      if(prune_needed && prune(fc::log_level::debug)) {
+         log.seek_end(-sizeof(uint32_t));
+         const uint32_t num_blocks_in_log = _end_block - _begin_block;
+         fc::raw::pack(log, num_blocks_in_log);
+         log.flush();
+      }
+
       auto partition_config = std::get_if<state_history::partition_config>(&_config);
       if (partition_config && block_num % partition_config->stride == 0) {
          split_log();
@@ -617,13 +739,23 @@ class state_history_log {
       return true;
    }
 
-   void prune(const fc::log_level& loglevel) {
+   //prune runs on the main thread, so it never waits for readers: a slow ship client would hold up every block.
+   //While the log is being read the prune is deferred to the next write.
+   //returns true if the log was pruned, the caller is responsible for updating the trailing block count
+   bool prune(const fc::log_level& loglevel) {
       auto prune_config = std::get_if<state_history::prune_config>(&_config);
 
       if(!prune_config)
-         return;
+         return false;
+      _prune_pending = false;
       if(_end_block - _begin_block <= prune_config->prune_blocks)
-         return;
+         return false;
+
+      if(!_readers.try_rewrite()) {
+         dlog("${name}.log prune deferred, log is being read", ("name", name));
+         _prune_pending = true;
+         return false;
+      }
 
       const uint32_t prune_to_num = _end_block - prune_config->prune_blocks;
       uint64_t prune_to_pos = get_pos(prune_to_num);
@@ -636,6 +768,7 @@ class state_history_log {
       if(auto l = fc::logger::get(); l.is_enabled(loglevel))
          l.log(fc::log_message(fc::log_context(loglevel, __FILE__, __LINE__, __func__),
                                "${name}.log pruned to blocks ${b}-${e}", fc::mutable_variant_object()("name", name)("b", _begin_block)("e", _end_block - 1)));
+      return true;
    }
 
    //only works on non-pruned logs
@@ -774,7 +907,11 @@ class state_history_log {
       return pos;
    }
 
+   //called before anything of the new entry is written, _mx is released while waiting for readers.
+   //unlike prune this can not be deferred; forks are rare and readers hold the log for a single entry
    void truncate(uint32_t block_num) {
+      _readers.wait_for_readers();
+
       log.close();
       index.close();
 
@@ -1522,41 +1522,81 @@ string get_table_type( const abi_def& abi, const name& table_name ) {
    EOS_ASSERT( false, chain::contract_table_query_exception, "Table ${table} is not specified in the ABI", ("table",table_name) );
 }
 
-read_only::get_table_rows_return_t
-read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::time_point& deadline ) const {
-   abi_def abi = eosio::chain_apis::get_abi( db, p.code );
+void read_only::find_table_abis( table_rows_scan& scan, const name& code, std::shared_ptr<const chain::abi_def> abi ) const {
+   if( !abi )
+      return;
+   const auto* meta = db.db().find<chain::account_metadata_object, chain::by_name>( code );
+   if( meta == nullptr )
+      return;
+   scan.code = code;
+   scan.abi_sequence = meta->abi_sequence;
+   const auto& cache = db.get_abi_cache();
+   // generation first, a serializer found after it was taken is still current for this read window
+   scan.abi_cache_generation = cache.generation( code );
+   scan.abis = cache.find( code, meta->abi_sequence );
+   if( !scan.abis )
+      scan.abi = std::move( abi );
+}
+
+void read_only::resolve_abis( table_rows_scan& scan, const chain::versioned_abi_cache& cache,
+                              const fc::microseconds& abi_serializer_max_time ) {
+   if( scan.abis || !scan.abi )
+      return;
+   // not inserted with get(): outside the read window, invalidate() may have run since scan.abi was read
+   scan.abis = std::make_shared<const abi_serializer>( *scan.abi, abi_serializer::create_yield_function( abi_serializer_max_time ) );
+   cache.insert( scan.code, scan.abi_sequence, scan.abis, scan.abi_cache_generation );
+   scan.abi.reset();
+}
+
+read_only::table_rows_scan
+read_only::scan_table_rows( const read_only::get_table_rows_params& p, const fc::time_point& deadline ) const {
+   const auto* code_accnt = db.db().find<account_object, by_name>( p.code );
+   EOS_ASSERT( code_accnt != nullptr, chain::account_query_exception, "Fail to retrieve account for ${account}", ("account", p.code) );
+   abi_def abi;
+   const bool has_abi = abi_serializer::to_abi( code_accnt->abi, abi );
+
+   table_rows_scan scan = scan_table_index( p, abi, deadline );
+   // rows are decoded with the shared serializer of the current abi, only needed when returning json. Building
+   // a serializer not cached yet is left to resolve_abis on the http thread pool.
+   if( p.json )
+      find_table_abis( scan, p.code, has_abi ? std::make_shared<const abi_def>( std::move(abi) ) : nullptr );
+   return scan;
+}
+
+read_only::table_rows_scan
+read_only::scan_table_index( const read_only::get_table_rows_params& p, const abi_def& abi, const fc::time_point& deadline ) const {
    bool primary = false;
    auto table_with_index = get_table_index_name( p, primary );
    if( primary ) {
       EOS_ASSERT( p.table == table_with_index, chain::contract_table_query_exception, "Invalid table name ${t}", ( "t", p.table ));
       auto table_type = get_table_type( abi, p.table );
       if( table_type == KEYi64 || p.key_type == "i64" || p.key_type == "name" ) {
-         return get_table_rows_ex<key_value_index>(p,std::move(abi),deadline);
+         return get_table_rows_ex<key_value_index>(p, deadline);
       }
       EOS_ASSERT( false, chain::contract_table_query_exception,  "Invalid table type ${type}", ("type",table_type)("abi",abi));
    } else {
       EOS_ASSERT( !p.key_type.empty(), chain::contract_table_query_exception, "key type required for non-primary index" );
 
       if (p.key_type == chain_apis::i64 || p.key_type == "name") {
-         return get_table_rows_by_seckey<index64_index, uint64_t>(p, std::move(abi), deadline, [](uint64_t v)->uint64_t {
+         return get_table_rows_by_seckey<index64_index, uint64_t>(p, deadline, [](uint64_t v)->uint64_t {
             return v;
          });
       }
       else if (p.key_type == chain_apis::i128) {
-         return get_table_rows_by_seckey<index128_index, uint128_t>(p, std::move(abi), deadline, [](uint128_t v)->uint128_t {
+         return get_table_rows_by_seckey<index128_index, uint128_t>(p, deadline, [](uint128_t v)->uint128_t {
             return v;
          });
       }
       else if (p.key_type == chain_apis::i256) {
          if ( p.encode_type == chain_apis::hex) {
             using  conv = keytype_converter<chain_apis::sha256,chain_apis::hex>;
-            return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, conv::function());
+            return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, deadline, conv::function());
          }
          using  conv = keytype_converter<chain_apis::i256>;
-         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, conv::function());
+         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, deadline, conv::function());
       }
       else if (p.key_type == chain_apis::float64) {
-         return get_table_rows_by_seckey<index_double_index, double>(p, std::move(abi), deadline, [](double v)->float64_t {
+         return get_table_rows_by_seckey<index_double_index, double>(p, deadline, [](double v)->float64_t {
             float64_t f;
             double_to_float64(v, f);
             return f;
@@ -1564,13 +1604,13 @@ read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::
       }
       else if (p.key_type == chain_apis::float128) {
          if ( p.encode_type == chain_apis::hex) {
-            return get_table_rows_by_seckey<index_long_double_index, uint128_t>(p, std::move(abi), deadline, [](uint128_t v)->float128_t{
+            return get_table_rows_by_seckey<index_long_double_index, uint128_t>(p, deadline, [](uint128_t v)->float128_t{
                float128_t f;
                uint128_to_float128(v, f);
                return f;
             });
          }
-         return get_table_rows_by_seckey<index_long_double_index, double>(p, std::move(abi), deadline, [](double v)->float128_t{
+         return get_table_rows_by_seckey<index_long_double_index, double>(p, deadline, [](double v)->float128_t{
             float64_t f;
             double_to_float64(v, f);
             float128_t f128;
@@ -1580,16 +1620,206 @@ read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::
       }
       else if (p.key_type == chain_apis::sha256) {
          using  conv = keytype_converter<chain_apis::sha256,chain_apis::hex>;
-         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, conv::function());
+         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, deadline, conv::function());
       }
       else if(p.key_type == chain_apis::ripemd160) {
          using  conv = keytype_converter<chain_apis::ripemd160,chain_apis::hex>;
-         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, std::move(abi), deadline, conv::function());
+         return get_table_rows_by_seckey<conv::index_type, conv::input_type>(p, deadline, conv::function());
       }
       EOS_ASSERT(false, chain::contract_table_query_exception,  "Unsupported secondary index type: ${t}", ("t", p.key_type));
    }
 }
 
+read_only::get_table_rows_return_t
+read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::time_point& deadline ) const {
+   // not enforcing the deadline for that second processing part (the serialization), as it is not taking place
+   // on the main thread, but in the http thread pool.
+   return [scan = scan_table_rows( p, deadline ), &cache = db.get_abi_cache(), abi_serializer_max_time=abi_serializer_max_time]() mutable ->
+      chain::t_or_exception<read_only::get_table_rows_result> {
+      read_only::get_table_rows_result result;
+      type_name table_type;
+      if( scan.json ) {
+         resolve_abis( scan, cache, abi_serializer_max_time );
+         EOS_ASSERT( scan.abis, chain::contract_table_query_exception, "No ABI to decode table ${t}", ("t", scan.table) );
+         table_type = scan.abis->get_table_type( scan.table );
+      }
+
+      result.rows.reserve( scan.rows.size() );
+      for( const auto& row : scan.rows ) {
+         fc::variant data_var;
+         if( scan.json ) {
+            auto ds = scan.row_stream( row );
+            data_var = scan.abis->binary_to_variant( table_type, ds,
+                                                     abi_serializer::create_yield_function( abi_serializer_max_time ),
+                                                     scan.shorten_abi_errors );
+         } else {
+            data_var = fc::variant( vector<char>( scan.data.data() + row.offset, scan.data.data() + row.offset + row.size ) );
+         }
+
+         if( scan.show_payer ) {
+            result.rows.emplace_back( fc::mutable_variant_object( "data", std::move(data_var) )( "payer", row.payer ) );
+         } else {
+            result.rows.emplace_back( std::move(data_var) );
+         }
+      }
+      result.more = scan.more;
+      result.next_key = scan.next_key;
+      return result;
+   };
+}
+
+read_only::get_table_rows_json_return_t
+read_only::get_table_rows_json( const read_only::get_table_rows_params& p, const fc::time_point& deadline ) const {
+   return [scan = scan_table_rows( p, deadline ), &cache = db.get_abi_cache(), abi_serializer_max_time=abi_serializer_max_time]() mutable ->
+      chain::t_or_exception<fc::raw_json> {
+      resolve_abis( scan, cache, abi_serializer_max_time );
+      fc::raw_json result;
+      const fc::json::yield_function_t yield = [](size_t) {};
+      fc::json_writer w( result.json, yield );
+      write_table_rows( w, scan, abi_serializer_max_time );
+      return result;
+   };
+}
+
+// writes the same JSON as get_table_rows_result, a row at a time
+void read_only::write_table_rows( fc::json_writer& w, const table_rows_scan& scan, const fc::microseconds& abi_serializer_max_time,
+                                  const string* scope ) {
+   type_name table_type;
+   if( scan.json ) {
+      EOS_ASSERT( scan.abis, chain::contract_table_query_exception, "No ABI to decode table ${t}", ("t", scan.table) );
+      table_type = scan.abis->get_table_type( scan.table );
+   }
+
+   w.put( '{' );
+   if( scope ) {
+      w.write_key( "scope" );
+      w.write_string( *scope );
+      w.put( ',' );
+   }
+   w.write_key( "rows" );
+   w.put( '[' );
+   for( size_t i = 0; i < scan.rows.size(); ++i ) {
+      const auto& row = scan.rows[i];
+      if( i )
+         w.put( ',' );
+      if( scan.show_payer ) {
+         w.put( '{' );
+         w.write_key( "data" );
+      }
+      if( scan.json ) {
+         auto ds = scan.row_stream( row );
+         w.write( scan.abis->binary_to_variant( table_type, ds, abi_serializer::create_yield_function( abi_serializer_max_time ),
+                                                scan.shorten_abi_errors ) );
+      } else {
+         w.write_hex( scan.data.data() + row.offset, row.size );
+      }
+      if( scan.show_payer ) {
+         w.put( ',' );
+         w.write_key( "payer" );
+         w.write_string( row.payer.to_string() );
+         w.put( '}' );
+      }
+   }
+   w.put( ']' );
+   w.put( ',' );
+   w.write_key( "more" );
+   w.write( scan.more );
+   w.put( ',' );
+   w.write_key( "next_key" );
+   w.write_string( scan.next_key );
+   w.put( '}' );
+}
+
+read_only::get_table_rows_batch_return_t
+read_only::get_table_rows_batch( const read_only::get_table_rows_batch_params& p, const fc::time_point& deadline ) const {
+   fc::time_point params_deadline = p.time_limit_ms ? std::min(fc::time_point::now().safe_add(fc::milliseconds(*p.time_limit_ms)), deadline) : deadline;
+   const bool limited = deadline != fc::time_point::maximum();
+   EOS_ASSERT( !limited || p.scopes.size() <= max_return_items, chain::contract_table_query_exception,
+               "Too many scopes ${n}, at most ${m}", ("n", p.scopes.size())("m", max_return_items) );
+   EOS_ASSERT( !limited || p.keys.size() <= max_return_items, chain::contract_table_query_exception,
+               "Too many keys ${n}, at most ${m}", ("n", p.keys.size())("m", max_return_items) );
+
+   // resolved once for all scopes
+   abi_def abi = eosio::chain_apis::get_abi( db, p.code );
+   auto table_type = get_table_type( abi, p.table );
+   EOS_ASSERT( table_type == KEYi64 || p.key_type == "i64" || p.key_type == "name", chain::contract_table_query_exception,
+               "Invalid table type ${type}", ("type",table_type) );
+   std::shared_ptr<const abi_def> json_abi;
+   if( p.json )
+      json_abi = std::make_shared<const abi_def>( std::move(abi) );
+
+   vector<uint64_t> keys;
+   keys.reserve( p.keys.size() );
+   for( const auto& k : p.keys )
+      keys.push_back( p.key_type == "name" ? name(k).to_uint64_t() : convert_to_type<uint64_t>( k, "key" ) );
+
+   struct batch_t {
+      vector<std::pair<string, table_rows_scan>> scopes;
+      bool more = false;
+   };
+   batch_t batch;
+   batch.scopes.reserve( p.scopes.size() );
+
+   const auto& d = db.db();
+   uint32_t remaining = limited ? max_return_items : std::numeric_limits<uint32_t>::max();
+   for( const auto& scope : p.scopes ) {
+      const uint32_t needed = keys.empty() ? 1 : keys.size();
+      if( remaining < needed || fc::time_point::now() >= params_deadline ) {
+         batch.more = true;
+         break;
+      }
+
+      table_rows_scan scan;
+      if( keys.empty() ) {
+         get_table_rows_params sp{ .json = p.json, .code = p.code, .scope = scope, .table = p.table,
+                                   .limit = std::min( p.limit, remaining ), .key_type = p.key_type, .show_payer = p.show_payer };
+         scan = get_table_rows_ex<key_value_index>( sp, params_deadline );
+         remaining -= scan.rows.size();
+      } else {
+         scan = table_rows_scan{ .table = p.table, .shorten_abi_errors = shorten_abi_errors, .json = p.json,
+                                 .show_payer = p.show_payer && *p.show_payer };
+         const name scope_name{ convert_to_type<uint64_t>( scope, "scope" ) };
+         const auto* t_id = d.find<chain::table_id_object, chain::by_code_scope_table>( boost::make_tuple( p.code, scope_name, p.table ) );
+         if( t_id != nullptr ) {
+            scan.rows.reserve( keys.size() );
+            for( uint64_t key : keys ) {
+               const auto* row = d.find<chain::key_value_object, chain::by_scope_primary>( boost::make_tuple( t_id->id, key ) );
+               if( row != nullptr )
+                  scan.add_row( *row, row->payer );
+            }
+         }
+         remaining -= keys.size();
+      }
+      if( p.json )
+         find_table_abis( scan, p.code, json_abi );
+      batch.scopes.emplace_back( scope, std::move(scan) );
+   }
+
+   return [batch = std::move(batch), &cache = db.get_abi_cache(), abi_serializer_max_time=abi_serializer_max_time]() mutable
+          -> chain::t_or_exception<fc::raw_json> {
+      // built once for the first scope, found in the cache for the others
+      for( auto& s : batch.scopes )
+         resolve_abis( s.second, cache, abi_serializer_max_time );
+      fc::raw_json result;
+      const fc::json::yield_function_t yield = [](size_t) {};
+      fc::json_writer w( result.json, yield );
+      w.put( '{' );
+      w.write_key( "results" );
+      w.put( '[' );
+      for( size_t i = 0; i < batch.scopes.size(); ++i ) {
+         if( i )
+            w.put( ',' );
+         write_table_rows( w, batch.scopes[i].second, abi_serializer_max_time, &batch.scopes[i].first );
+      }
+      w.put( ']' );
+      w.put( ',' );
+      w.write_key( "more" );
+      w.write( batch.more );
+      w.put( '}' );
+      return result;
+   };
+}
+
 read_only::get_table_by_scope_result read_only::get_table_by_scope( const read_only::get_table_by_scope_params& p,
                                                                     const fc::time_point& deadline )const {
 
@@ -20,6 +20,7 @@
 #include <eosio/chain_plugin/trx_retry_db.hpp>
 #include <eosio/chain_plugin/trx_finality_status_processing.hpp>
 
+#include <fc/io/json_writer.hpp>
 #include <fc/static_variant.hpp>
 #include <fc/time.hpp>
 
@@ -51,14 +52,18 @@ namespace eosio {
 
    enum class throw_on_yield { no, yes };
    inline auto make_resolver(const controller& control, fc::microseconds abi_serializer_max_time, throw_on_yield yield_throw ) {
-      return [&control, abi_serializer_max_time, yield_throw](const account_name& name) -> std::optional<abi_serializer> {
+      return [&control, abi_serializer_max_time, yield_throw](const account_name& name) -> chain::abi_serializer_ptr {
          if (name.good()) {
             const auto* accnt = control.db().template find<chain::account_object, chain::by_name>( name );
-            if( accnt != nullptr ) {
+            const auto* meta = control.db().template find<chain::account_metadata_object, chain::by_name>( name );
+            if( accnt != nullptr && meta != nullptr ) {
                try {
-                  if( abi_def abi; abi_serializer::to_abi( accnt->abi, abi ) ) {
-                     return abi_serializer( std::move( abi ), abi_serializer::create_yield_function( abi_serializer_max_time ) );
-                  }
+                  return control.get_abi_cache().get( name, meta->abi_sequence, [&]() -> chain::abi_serializer_ptr {
+                     if( abi_def abi; abi_serializer::to_abi( accnt->abi, abi ) ) {
+                        return std::make_shared<const abi_serializer>( std::move( abi ), abi_serializer::create_yield_function( abi_serializer_max_time ) );
+                     }
+                     return {};
+                  } );
                } catch( ... ) {
                   if( yield_throw == throw_on_yield::yes )
                      throw;
@@ -441,6 +446,74 @@ public:
    
    get_table_rows_return_t get_table_rows( const get_table_rows_params& params, const fc::time_point& deadline )const;
 
+   /// same response as get_table_rows, rows are written straight to JSON without a get_table_rows_result
+   using get_table_rows_json_return_t = std::function<chain::t_or_exception<fc::raw_json>()>;
+
+   get_table_rows_json_return_t get_table_rows_json( const get_table_rows_params& params, const fc::time_point& deadline )const;
+
+   /// rows found by a table scan, copied back to back into one buffer and serialized later on the http thread pool
+   struct table_rows_scan {
+      struct row {
+         size_t   offset = 0;
+         uint32_t size = 0;
+         name     payer;
+      };
+
+      name                      table;
+      bool                      shorten_abi_errors = false;
+      bool                      json = false;
+      bool                      show_payer = false;
+      bool                      more = false;
+      std::string               next_key;
+      vector<char>              data;
+      vector<row>               rows;
+      chain::abi_serializer_ptr abis; ///< set when json, see resolve_abis
+      /// abi of code when json and its serializer was not cached, built by resolve_abis off the main thread
+      std::shared_ptr<const chain::abi_def> abi;
+      name                      code;
+      uint64_t                  abi_sequence = 0;
+      uint64_t                  abi_cache_generation = 0; ///< taken in the read window when abi is set
+
+      void add_row(const chain::key_value_object& obj, name payer) {
+         rows.push_back(row{data.size(), static_cast<uint32_t>(obj.value.size()), payer});
+         data.insert(data.end(), obj.value.data(), obj.value.data() + obj.value.size());
+      }
+      fc::datastream<const char*> row_stream(const row& r) const { return {data.data() + r.offset, r.size}; }
+   };
+
+   table_rows_scan scan_table_rows( const get_table_rows_params& params, const fc::time_point& deadline )const;
+   table_rows_scan scan_table_index( const get_table_rows_params& params, const chain::abi_def& abi, const fc::time_point& deadline )const;
+   /// sets scan.abis from the abi cache, or keeps abi in scan.abi on a miss; abi is nullptr when code has none
+   void find_table_abis( table_rows_scan& scan, const name& code, std::shared_ptr<const chain::abi_def> abi )const;
+   /// builds scan.abis from scan.abi when needed, called on the http thread pool. The serializer is cached only if
+   /// the cache was not invalidated for code since find_table_abis.
+   static void resolve_abis( table_rows_scan& scan, const chain::versioned_abi_cache& cache,
+                             const fc::microseconds& abi_serializer_max_time );
+   /// writes {"rows":[..],"more":..,"next_key":..}, prefixed by "scope" when given
+   static void write_table_rows( fc::json_writer& w, const table_rows_scan& scan, const fc::microseconds& abi_serializer_max_time,
+                                 const string* scope = nullptr );
+
+   struct get_table_rows_batch_params {
+      bool                    json = false;
+      name                    code;
+      name                    table;
+      vector<string>          scopes;
+      vector<string>          keys;     ///< primary keys looked up in every scope, all rows up to limit when empty
+      string                  key_type; ///< of keys and next_key, "name" or "i64"
+      uint32_t                limit = 10; ///< rows per scope when keys is empty
+      std::optional<bool>     show_payer; // show RAM payer
+      std::optional<uint32_t> time_limit_ms; // defaults to http-max-response-time-ms
+   };
+
+   /**
+    * get_table_rows of the primary index of one (code, table) for many scopes in one request, sharing the abi.
+    * Response is {"results":[{"scope":..,"rows":[..],"more":..,"next_key":..},..],"more":..}, the outer more is
+    * set when not all scopes were looked up because of the time or row limit; results are in order of scopes.
+    */
+   using get_table_rows_batch_return_t = std::function<chain::t_or_exception<fc::raw_json>()>;
+
+   get_table_rows_batch_return_t get_table_rows_batch( const get_table_rows_batch_params& params, const fc::time_point& deadline )const;
+
    struct get_table_by_scope_params {
       name                 code; // mandatory
       name                 table; // optional, act as filter
@@ -572,25 +645,15 @@ public:
    static uint64_t get_table_index_name(const read_only::get_table_rows_params& p, bool& primary);
 
    template <typename IndexType, typename SecKeyType, typename ConvFn>
-   get_table_rows_return_t
+   table_rows_scan
    get_table_rows_by_seckey( const read_only::get_table_rows_params& p,
-                             abi_def&& abi,
                              const fc::time_point& deadline,
                              ConvFn conv ) const {
 
       fc::time_point params_deadline = p.time_limit_ms ? std::min(fc::time_point::now().safe_add(fc::milliseconds(*p.time_limit_ms)), deadline) : deadline;
 
-      struct http_params_t {
-         name table;
-         bool shorten_abi_errors;
-         bool json;
-         bool show_payer;
-         bool more;
-         std::string next_key;
-         vector<std::pair<vector<char>, name>> rows;
-      };
-      
-      http_params_t http_params { p.table, shorten_abi_errors, p.json, p.show_payer && *p.show_payer, false  };
+      table_rows_scan scan { .table = p.table, .shorten_abi_errors = shorten_abi_errors, .json = p.json,
+                             .show_payer = p.show_payer && *p.show_payer };
          
       const auto& d = db.db();
 
@@ -641,26 +704,23 @@ public:
          }
 
          if( upper_bound_lookup_tuple < lower_bound_lookup_tuple )
-            return []() ->  chain::t_or_exception<read_only::get_table_rows_result> {
-               return read_only::get_table_rows_result();
-            };
+            return table_rows_scan();
 
          auto walk_table_row_range = [&]( auto itr, auto end_itr ) {
-            vector<char> data;
             uint32_t limit = p.limit;
             if (deadline != fc::time_point::maximum() && limit > max_return_items)
                limit = max_return_items;
+            scan.rows.reserve( std::min<uint32_t>( limit, max_return_items ) );
             for( unsigned int count = 0; count < limit && itr != end_itr; ++count, ++itr ) {
                const auto* itr2 = d.find<chain::key_value_object, chain::by_scope_primary>( boost::make_tuple(t_id->id, itr->primary_key) );
                if( itr2 == nullptr ) continue;
-               copy_inline_row(*itr2, data);
-               http_params.rows.emplace_back(std::move(data), itr->payer);
+               scan.add_row(*itr2, itr->payer);
                if (fc::time_point::now() >= params_deadline)
                   break;
             }
             if( itr != end_itr ) {
-               http_params.more = true;
-               http_params.next_key = convert_to_string(itr->secondary_key, p.key_type, p.encode_type, "next_key - next lower bound");
+               scan.more = true;
+               scan.next_key = convert_to_string(itr->secondary_key, p.key_type, p.encode_type, "next_key - next lower bound");
             }
          };
 
@@ -673,56 +733,18 @@ public:
          }
       }
 
-      // not enforcing the deadline for that second processing part (the serialization), as it is not taking place
-      // on the main thread, but in the http thread pool.
-      return [p = std::move(http_params), abi=std::move(abi), abi_serializer_max_time=abi_serializer_max_time]() mutable ->
-         chain::t_or_exception<read_only::get_table_rows_result> {
-         read_only::get_table_rows_result result;
-         abi_serializer abis;
-         abis.set_abi(std::move(abi), abi_serializer::create_yield_function(abi_serializer_max_time));
-         auto table_type = abis.get_table_type(p.table);
-         
-         for (auto& row : p.rows) {
-            fc::variant data_var;
-            if( p.json ) {
-               data_var = abis.binary_to_variant(table_type, row.first,
-                                                 abi_serializer::create_yield_function(abi_serializer_max_time),
-                                                 p.shorten_abi_errors );
-            } else {
-               data_var = fc::variant(row.first);
-            }
-
-            if (p.show_payer) {
-               result.rows.emplace_back(fc::mutable_variant_object("data", std::move(data_var))("payer", row.second));
-            } else {
-               result.rows.emplace_back(std::move(data_var));
-            }            
-         }
-         result.more = p.more;
-         result.next_key = p.next_key;
-         return result;
-      };
+      return scan;
    }
 
    template <typename IndexType>
-   get_table_rows_return_t
+   table_rows_scan
    get_table_rows_ex( const read_only::get_table_rows_params& p,
-                      abi_def&& abi,
                       const fc::time_point& deadline ) const {
 
       fc::time_point params_deadline = p.time_limit_ms ? std::min(fc::time_point::now().safe_add(fc::milliseconds(*p.time_limit_ms)), deadline) : deadline;
 
-      struct http_params_t {
-         name table;
-         bool shorten_abi_errors;
-         bool json;
-         bool show_payer;
-         bool more;
-         std::string next_key;
-         vector<std::pair<vector<char>, name>> rows;
-      };
-      
-      http_params_t http_params { p.table, shorten_abi_errors, p.json, p.show_payer && *p.show_payer, false  };
+      table_rows_scan scan { .table = p.table, .shorten_abi_errors = shorten_abi_errors, .json = p.json,
+                             .show_payer = p.show_payer && *p.show_payer };
          
       const auto& d = db.db();
 
@@ -755,24 +777,21 @@ public:
          }
 
          if( upper_bound_lookup_tuple < lower_bound_lookup_tuple  )
-            return []() ->  chain::t_or_exception<read_only::get_table_rows_result> {
-               return read_only::get_table_rows_result();
-            };
+            return table_rows_scan();
 
          auto walk_table_row_range = [&]( auto itr, auto end_itr ) {
-            vector<char> data;
             uint32_t limit = p.limit;
             if (deadline != fc::time_point::maximum() && limit > max_return_items)
                limit = max_return_items;
+            scan.rows.reserve( std::min<uint32_t>( limit, max_return_items ) );
             for( unsigned int count = 0; count < limit && itr != end_itr; ++count, ++itr ) {
-               copy_inline_row(*itr, data);
-               http_params.rows.emplace_back(std::move(data), itr->payer);
+               scan.add_row(*itr, itr->payer);
                if (fc::time_point::now() >= params_deadline)
                   break;
             }
             if( itr != end_itr ) {
-               http_params.more = true;
-               http_params.next_key = convert_to_string(itr->primary_key, p.key_type, p.encode_type, "next_key - next lower bound");
+               scan.more = true;
+               scan.next_key = convert_to_string(itr->primary_key, p.key_type, p.encode_type, "next_key - next lower bound");
             }
          };
 
@@ -785,35 +804,7 @@ public:
          }
       }
       
-      // not enforcing the deadline for that second processing part (the serialization), as it is not taking place
-      // on the main thread, but in the http thread pool.
-      return [p = std::move(http_params), abi=std::move(abi), abi_serializer_max_time=abi_serializer_max_time]() mutable ->
-         chain::t_or_exception<read_only::get_table_rows_result> {
-         read_only::get_table_rows_result result;
-         abi_serializer abis;
-         abis.set_abi(std::move(abi), abi_serializer::create_yield_function(abi_serializer_max_time));
-         auto table_type = abis.get_table_type(p.table);
-         
-         for (auto& row : p.rows) {
-            fc::variant data_var;
-            if( p.json ) {
-               data_var = abis.binary_to_variant(table_type, row.first,
-                                                 abi_serializer::create_yield_function(abi_serializer_max_time),
-                                                 p.shorten_abi_errors );
-            } else {
-               data_var = fc::variant(row.first);
-            }
-
-            if (p.show_payer) {
-               result.rows.emplace_back(fc::mutable_variant_object("data", std::move(data_var))("payer", row.second));
-            } else {
-               result.rows.emplace_back(std::move(data_var));
-            }            
-         }
-         result.more = p.more;
-         result.next_key = p.next_key;
-         return result;
-      };
+      return scan;
    }
 
    using get_accounts_by_authorizers_result = account_query_db::get_accounts_by_authorizers_result;
@@ -1036,6 +1027,7 @@ FC_REFLECT( eosio::chain_apis::read_write::send_transaction2_params, (return_fai
 
 FC_REFLECT( eosio::chain_apis::read_only::get_table_rows_params, (json)(code)(scope)(table)(table_key)(lower_bound)(upper_bound)(limit)(key_type)(index_position)(encode_type)(reverse)(show_payer)(time_limit_ms) )
 FC_REFLECT( eosio::chain_apis::read_only::get_table_rows_result, (rows)(more)(next_key) );
+FC_REFLECT( eosio::chain_apis::read_only::get_table_rows_batch_params, (json)(code)(table)(scopes)(keys)(key_type)(limit)(show_payer)(time_limit_ms) )
 
 FC_REFLECT( eosio::chain_apis::read_only::get_table_by_scope_params, (code)(table)(lower_bound)(upper_bound)(limit)(reverse)(time_limit_ms) )
 FC_REFLECT( eosio::chain_apis::read_only::get_table_by_scope_result_row, (code)(scope)(table)(payer)(count));
@@ -1080,3 +1072,10 @@ FC_REFLECT( eosio::chain_apis::read_only::compute_transaction_results, (transact
 FC_REFLECT( eosio::chain_apis::read_only::send_read_only_transaction_params, (transaction))
 FC_REFLECT( eosio::chain_apis::read_only::send_read_only_transaction_results, (transaction_id)(processed) )
 FC_REFLECT( eosio::chain_apis::read_only::get_consensus_parameters_results, (chain_config)(wasm_config))
+
+// results written member by member by fc::json_writer, on the http thread pool for posted endpoints
+FC_JSON_WRITE_REFLECTED( eosio::chain_apis::linked_action )
+FC_JSON_WRITE_REFLECTED( eosio::chain_apis::permission )
+FC_JSON_WRITE_REFLECTED( eosio::chain_apis::read_only::get_table_rows_result )
+FC_JSON_WRITE_REFLECTED( eosio::chain_apis::read_only::account_resource_info )
+FC_JSON_WRITE_REFLECTED( eosio::chain_apis::read_only::get_account_results )
@@ -151,7 +151,7 @@ namespace eosio {
                   return;
                }
 
-               url_response_callback wrapped_then = [then=std::move(then)](int code, std::optional<fc::variant> resp) {
+               url_response_callback wrapped_then = [then=std::move(then)](int code, std::optional<http_response_body> resp) {
                   then(code, std::move(resp));
                };
 
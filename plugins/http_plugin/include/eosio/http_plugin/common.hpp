@@ -89,6 +89,19 @@ static size_t in_flight_sizeof(const fc::variant& v) {
    return 0;
 }
 
+/**
+* Helper method to calculate the "in flight" size of a http_response_body
+* A body already serialized to JSON is exactly its size
+*
+* @param b - the http_response_body
+* @return in flight size of b
+*/
+static size_t in_flight_sizeof(const http_response_body& b) {
+   if (auto* json = std::get_if<json_response_body>(&b))
+      return json->json.size();
+   return in_flight_sizeof(std::get<fc::variant>(b));
+}
+
 /**
 * Helper method to calculate the "in flight" size of a std::optional<T>
 * When the optional doesn't contain value, it will return the size of 0
@@ -154,13 +167,13 @@ struct http_plugin_state {
 */
 inline auto make_http_response_handler(http_plugin_state& plugin_state, detail::abstract_conn_ptr session_ptr, http_content_type content_type) {
    return [&plugin_state,
-           session_ptr{std::move(session_ptr)}, content_type](int code, std::optional<fc::variant> response) mutable {
+           session_ptr{std::move(session_ptr)}, content_type](int code, std::optional<http_response_body> response) mutable {
       auto payload_size = detail::in_flight_sizeof(response);
       plugin_state.bytes_in_flight += payload_size;
 
       // post back to an HTTP thread to allow the response handler to be called from any thread
       boost::asio::dispatch(plugin_state.thread_pool.get_executor(),
-                        [&plugin_state, session_ptr{std::move(session_ptr)}, code, payload_size, response = std::move(response), content_type]() {
+                        [&plugin_state, session_ptr{std::move(session_ptr)}, code, payload_size, response = std::move(response), content_type]() mutable {
                            auto on_exit = fc::scoped_exit<std::function<void()>>([&](){plugin_state.bytes_in_flight -= payload_size;});
 
                            if(auto error_str = session_ptr->verify_max_bytes_in_flight(0); !error_str.empty()) {
@@ -170,7 +183,13 @@ inline auto make_http_response_handler(http_plugin_state& plugin_state, detail::
 
                            try {
                               if (response.has_value()) {
-                                 std::string json = (content_type == http_content_type::plaintext) ? response->as_string() : fc::json::to_string(*response, fc::time_point::maximum());
+                                 std::string json;
+                                 if (auto* body = std::get_if<json_response_body>(&*response))
+                                    json = std::move(body->json);
+                                 else if (content_type == http_content_type::plaintext)
+                                    json = std::get<fc::variant>(*response).as_string();
+                                 else
+                                    json = fc::json::to_string(std::get<fc::variant>(*response), fc::time_point::maximum());
                                  if (auto error_str = session_ptr->verify_max_bytes_in_flight(json.size()); error_str.empty())
                                     session_ptr->send_response(std::move(json), code);
                                  else
@@ -6,16 +6,45 @@
 #include <fc/exception/exception.hpp>
 #include <fc/reflect/reflect.hpp>
 #include <fc/io/json.hpp>
+#include <fc/io/json_writer.hpp>
+
+#include <variant>
+
 namespace eosio {
    using namespace appbase;
 
+   /**
+    * @brief A response body which is already JSON, sent as is
+    *
+    * See make_json_response_body()
+    */
+   struct json_response_body {
+      explicit json_response_body(std::string json) : json(std::move(json)) {}
+      std::string json;
+   };
+
+   using http_response_body = std::variant<fc::variant, json_response_body>;
+
+   /**
+    * @brief Serialize a response body straight to JSON with fc::json_writer,
+    * without building an fc::variant of the whole response first
+    */
+   template<typename T>
+   json_response_body make_json_response_body(const T& v) {
+      return json_response_body(fc::to_json_string(v));
+   }
+
+   inline json_response_body make_json_response_body(fc::raw_json&& v) {
+      return json_response_body(std::move(v.json));
+   }
+
    /**
     * @brief A callback function provided to a URL handler to
     * allow it to specify the HTTP response code and body
     *
     * Arguments: response_code, response_body
     */
-   using url_response_callback = std::function<void(int,std::optional<fc::variant>)>;
+   using url_response_callback = std::function<void(int,std::optional<http_response_body>)>;
 
    /**
     * @brief Callback type for a URL handler
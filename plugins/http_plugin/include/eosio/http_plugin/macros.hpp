@@ -46,9 +46,14 @@
 
 
 // call an API which returns either fc::exception_ptr, or a function to be posted on the http thread pool
-// for execution (typically doing the final serialization)
+// for execution (typically doing the final serialization). The result is written straight to JSON on the
+// http thread pool.
 // ------------------------------------------------------------------------------------------------------
 #define CALL_WITH_400_POST(api_name, category, api_handle, api_namespace, call_name, call_result, http_resp_code, params_type) \
+   CALL_WITH_400_POST_AS(api_name, category, api_handle, api_namespace, call_name, call_name, call_result, http_resp_code, params_type)
+
+// same as CALL_WITH_400_POST, but the url call_name is served by api_handle.api_call
+#define CALL_WITH_400_POST_AS(api_name, category, api_handle, api_namespace, call_name, api_call, call_result, http_resp_code, params_type) \
 {std::string("/v1/" #api_name "/" #call_name),                                                                  \
       api_category::category,                                                                                   \
       [api_handle, &_http_plugin](string&&, string&& body, url_response_callback&& cb) {                        \
@@ -57,7 +62,7 @@
              auto params = parse_params<api_namespace::call_name ## _params, params_type>(body);                \
              using http_fwd_t = std::function<chain::t_or_exception<call_result>()>;                            \
              /* called on main application thread */                                                            \
-             http_fwd_t http_fwd(api_handle.call_name(std::move(params), deadline));                            \
+             http_fwd_t http_fwd(api_handle.api_call(std::move(params), deadline));                             \
              _http_plugin.post_http_thread_pool([resp_code=http_resp_code, cb=std::move(cb),                    \
                                                  body=std::move(body),                                          \
                                                  http_fwd = std::move(http_fwd)]() {                            \
@@ -70,7 +75,7 @@
                          http_plugin::handle_exception(#api_name, #call_name, body, cb);                        \
                       }                                                                                         \
                    } else {                                                                                     \
-                      cb(resp_code, fc::variant(std::get<call_result>(std::move(result))));                     \
+                      cb(resp_code, make_json_response_body(std::move(std::get<call_result>(result))));         \
                    }                                                                                            \
                 } catch (...) {                                                                                 \
                    http_plugin::handle_exception(#api_name, #call_name, body, cb);                              \
@@ -20,6 +20,7 @@
 #include <fc/exception/exception.hpp>
 #include <fc/time.hpp>
 #include <fc/mutex.hpp>
+#include <fc/scoped_exit.hpp>
 #include <fc/network/listener.hpp>
 
 #include <boost/asio/ip/tcp.hpp>
@@ -27,11 +28,13 @@
 #include <boost/asio/steady_timer.hpp>
 #include <boost/multi_index/key.hpp>
 
+#include <array>
 #include <atomic>
 #include <cmath>
 #include <memory>
 #include <new>
 #include <regex>
+#include <set>
 
 // should be defined for c++17, but clang++16 still has not implemented it
 #ifdef __cpp_lib_hardware_interference_size
@@ -147,6 +150,33 @@ namespace eosio {
       >
       > peer_block_state_index;
 
+   /**
+    * One shard of a dedup index together with the mutex guarding it. Ids are spread over the shards by the
+    * bits of the sha256 following the block number prefix of a block id, which are uniformly distributed for
+    * both block and transaction ids, so connection strands looking up different ids rarely contend.
+    */
+   template<typename Index>
+   struct dedup_shard {
+      alignas(hardware_destructive_interference_size)
+      mutable fc::mutex mtx;
+      Index             index GUARDED_BY(mtx);
+   };
+
+   template<typename Index>
+   class sharded_dedup_index {
+   public:
+      static constexpr size_t num_shards = 16; // power of 2
+
+      dedup_shard<Index>& shard( const fc::sha256& id ) { return shards[id._hash[1] & (num_shards - 1)]; }
+      const dedup_shard<Index>& shard( const fc::sha256& id ) const { return shards[id._hash[1] & (num_shards - 1)]; }
+
+      auto begin() { return shards.begin(); }
+      auto end() { return shards.end(); }
+
+   private:
+      std::array<dedup_shard<Index>, num_shards> shards;
+   };
+
    struct unlinkable_block_state {
       block_id_type    id;
       signed_block_ptr block;
@@ -273,13 +303,13 @@ namespace eosio {
    };
 
    class dispatch_manager {
-      alignas(hardware_destructive_interference_size)
-      mutable fc::mutex      blk_state_mtx;
-      peer_block_state_index  blk_state GUARDED_BY(blk_state_mtx);
+      sharded_dedup_index<peer_block_state_index> blk_state;
+      sharded_dedup_index<node_transaction_index> local_txns;
 
+      // blocks whose headers are currently being validated on some connection strand
       alignas(hardware_destructive_interference_size)
-      mutable fc::mutex      local_txns_mtx;
-      node_transaction_index  local_txns GUARDED_BY(local_txns_mtx);
+      mutable fc::mutex                     blks_in_validation_mtx;
+      std::set<block_id_type, sha256_less>  blks_in_validation GUARDED_BY(blks_in_validation_mtx);
 
       unlinkable_block_state_cache unlinkable_block_cache;
 
@@ -304,6 +334,9 @@ namespace eosio {
       bool peer_has_block(const block_id_type& blkid, uint32_t connection_id) const;
       bool have_block(const block_id_type& blkid) const;
       void rm_block(const block_id_type& blkid);
+      // returns false if another connection is already validating the block header
+      bool start_block_validation(const block_id_type& blkid);
+      void end_block_validation(const block_id_type& blkid);
 
       bool add_peer_txn( const transaction_id_type& id, const time_point_sec& trx_expires, uint32_t connection_id,
                          const time_point_sec& now = time_point_sec(time_point::now()) );
@@ -342,6 +375,75 @@ namespace eosio {
    constexpr uint32_t signed_block_which       = fc::get_index<net_message, signed_block>();       // see protocol net_message
    constexpr uint32_t packed_transaction_which = fc::get_index<net_message, packed_transaction>(); // see protocol net_message
 
+   /**
+    * Limits a datastream to the bytes of the current message, so a length supplied by a peer can not move it past
+    * the end of the message. Overruns throw, which closes the connection.
+    */
+   template<typename Stream>
+   class bounded_datastream {
+   public:
+      bounded_datastream( Stream& ds, size_t limit ) : ds( ds ), remaining( limit ) {}
+
+      void skip( size_t s ) { consume( "skip", s ); ds.skip( s ); }
+      bool read( char* d, size_t s ) { consume( "read", s ); return ds.read( d, s ); }
+      bool get( unsigned char& c ) { consume( "get", 1 ); return ds.get( c ); }
+      bool get( char& c ) { consume( "get", 1 ); return ds.get( c ); }
+
+   private:
+      void consume( const char* method, size_t s ) {
+         if( s > remaining )
+            fc::detail::throw_datastream_range_error( method, remaining, s - remaining );
+         remaining -= s;
+      }
+
+      Stream& ds;
+      size_t  remaining;
+   };
+
+   /**
+    * Computes the id and expiration of a serialized packed_transaction without constructing it.
+    * The id of an uncompressed packed_transaction is the sha256 of its packed_trx bytes and the expiration is the
+    * first field of the packed transaction header, so both can be read straight out of the message buffer.
+    * @return false if the id can not be determined without a full unpack (compressed packed_trx)
+    */
+   template<typename Stream>
+   bool peek_packed_transaction_id( Stream& ds, transaction_id_type& id, time_point_sec& expiration ) {
+      unsigned_int num_sigs{};
+      fc::raw::unpack( ds, num_sigs );
+      for( uint32_t i = 0; i < num_sigs.value; ++i ) {
+         chain::signature_type sig;
+         fc::raw::unpack( ds, sig );
+      }
+      uint8_t compression = 0;
+      fc::raw::unpack( ds, compression );
+      if( compression != static_cast<uint8_t>(packed_transaction::compression_type::none) )
+         return false;
+      unsigned_int cfd_size{};
+      fc::raw::unpack( ds, cfd_size );
+      ds.skip( cfd_size.value );
+
+      unsigned_int trx_size{};
+      fc::raw::unpack( ds, trx_size );
+      if( trx_size.value < sizeof(uint32_t) )
+         return false;
+      char buf[512];
+      ds.read( buf, sizeof(uint32_t) );
+      uint32_t exp_sec = 0;
+      memcpy( &exp_sec, buf, sizeof(uint32_t) );
+      expiration = time_point_sec( exp_sec );
+
+      fc::sha256::encoder enc;
+      enc.write( buf, sizeof(uint32_t) );
+      for( uint32_t remaining = trx_size.value - sizeof(uint32_t); remaining > 0; ) {
+         const uint32_t n = std::min<uint32_t>( remaining, sizeof(buf) );
+         ds.read( buf, n );
+         enc.write( buf, n );
+         remaining -= n;
+      }
+      id = enc.result();
+      return true;
+   }
+
    class connections_manager {
    public:
       struct connection_detail {
@@ -1855,7 +1957,21 @@ namespace eosio {
          // this implementation is to avoid copy of signed_block to net_message
          // matches which of net_message for signed_block
          fc_dlog( logger, "sending block ${bn}", ("bn", sb->block_num()) );
-         return buffer_factory::create_send_buffer( signed_block_which, *sb );
+         // uses the block as received or as packed for the block log instead of packing it again
+         const std::shared_ptr<const bytes> packed = sb->packed_block();
+         const uint32_t which_size = fc::raw::pack_size( unsigned_int( signed_block_which ) );
+         const uint32_t payload_size = which_size + packed->size();
+
+         const char* const header = reinterpret_cast<const char* const>(&payload_size); // avoid variable size encoding of uint32_t
+         const size_t buffer_size = message_header_size + payload_size;
+
+         auto send_buffer = std::make_shared<vector<char>>( buffer_size );
+         fc::datastream<char*> ds( send_buffer->data(), buffer_size );
+         ds.write( header, message_header_size );
+         fc::raw::pack( ds, unsigned_int( signed_block_which ) );
+         ds.write( packed->data(), packed->size() );
+
+         return send_buffer;
       }
    };
 
@@ -2530,26 +2646,29 @@ namespace eosio {
 
    bool dispatch_manager::add_peer_block( const block_id_type& blkid, uint32_t connection_id) {
       uint32_t block_num = block_header::num_from_id(blkid);
-      fc::lock_guard g( blk_state_mtx );
-      auto bptr = blk_state.get<by_connection_id>().find( std::make_tuple(block_num, std::ref(blkid), connection_id) );
-      bool added = (bptr == blk_state.end());
+      auto& s = blk_state.shard( blkid );
+      fc::lock_guard g( s.mtx );
+      auto bptr = s.index.get<by_connection_id>().find( std::make_tuple(block_num, std::ref(blkid), connection_id) );
+      bool added = (bptr == s.index.end());
       if( added ) {
-         blk_state.insert( {blkid, connection_id} );
+         s.index.insert( {blkid, connection_id} );
       }
       return added;
    }
 
    bool dispatch_manager::peer_has_block( const block_id_type& blkid, uint32_t connection_id ) const {
       uint32_t block_num = block_header::num_from_id(blkid);
-      fc::lock_guard g(blk_state_mtx);
-      const auto blk_itr = blk_state.get<by_connection_id>().find( std::make_tuple(block_num, std::ref(blkid), connection_id) );
-      return blk_itr != blk_state.end();
+      const auto& s = blk_state.shard( blkid );
+      fc::lock_guard g( s.mtx );
+      const auto blk_itr = s.index.get<by_connection_id>().find( std::make_tuple(block_num, std::ref(blkid), connection_id) );
+      return blk_itr != s.index.end();
    }
 
    bool dispatch_manager::have_block( const block_id_type& blkid ) const {
       uint32_t block_num = block_header::num_from_id(blkid);
-      fc::lock_guard g(blk_state_mtx);
-      const auto& index = blk_state.get<by_connection_id>();
+      const auto& s = blk_state.shard( blkid );
+      fc::lock_guard g( s.mtx );
+      const auto& index = s.index.get<by_connection_id>();
       auto blk_itr = index.find( std::make_tuple(block_num, std::ref(blkid)) );
       return blk_itr != index.end();
    }
@@ -2557,22 +2676,34 @@ namespace eosio {
    void dispatch_manager::rm_block( const block_id_type& blkid ) {
       uint32_t block_num = block_header::num_from_id(blkid);
       fc_dlog( logger, "rm_block ${n}, id: ${id}", ("n", block_num)("id", blkid));
-      fc::lock_guard g(blk_state_mtx);
-      auto& index = blk_state.get<by_connection_id>();
+      auto& s = blk_state.shard( blkid );
+      fc::lock_guard g( s.mtx );
+      auto& index = s.index.get<by_connection_id>();
       auto p = index.equal_range( std::make_tuple(block_num, std::ref(blkid)) );
       index.erase(p.first, p.second);
    }
 
+   bool dispatch_manager::start_block_validation( const block_id_type& blkid ) {
+      fc::lock_guard g( blks_in_validation_mtx );
+      return blks_in_validation.insert( blkid ).second;
+   }
+
+   void dispatch_manager::end_block_validation( const block_id_type& blkid ) {
+      fc::lock_guard g( blks_in_validation_mtx );
+      blks_in_validation.erase( blkid );
+   }
+
    bool dispatch_manager::add_peer_txn( const transaction_id_type& id, const time_point_sec& trx_expires,
                                         uint32_t connection_id, const time_point_sec& now ) {
-      fc::lock_guard g( local_txns_mtx );
-      auto tptr = local_txns.get<by_id>().find( std::make_tuple( std::ref( id ), connection_id ) );
-      bool added = (tptr == local_txns.end());
+      auto& s = local_txns.shard( id );
+      fc::lock_guard g( s.mtx );
+      auto tptr = s.index.get<by_id>().find( std::make_tuple( std::ref( id ), connection_id ) );
+      bool added = (tptr == s.index.end());
       if( added ) {
          // expire at either transaction expiration or configured max expire time whichever is less
          time_point_sec expires{now.to_time_point() + my_impl->p2p_dedup_cache_expire_time_us};
          expires = std::min( trx_expires, expires );
-         local_txns.insert( node_transaction_state{
+         s.index.insert( node_transaction_state{
             .id = id,
             .expires = expires,
             .connection_id = connection_id} );
@@ -2581,22 +2712,26 @@ namespace eosio {
    }
 
    bool dispatch_manager::have_txn( const transaction_id_type& tid ) const {
-      fc::lock_guard g( local_txns_mtx );
-      const auto tptr = local_txns.get<by_id>().find( tid );
-      return tptr != local_txns.end();
+      const auto& s = local_txns.shard( tid );
+      fc::lock_guard g( s.mtx );
+      const auto tptr = s.index.get<by_id>().find( tid );
+      return tptr != s.index.end();
    }
 
+   // expires one shard at a time so lookups on the other shards are never blocked
    void dispatch_manager::expire_txns() {
       size_t start_size = 0, end_size = 0;
       fc::time_point_sec now{time_point::now()};
 
-      fc::unique_lock g( local_txns_mtx );
-      start_size = local_txns.size();
-      auto& old = local_txns.get<by_expiry>();
-      auto ex_lo = old.lower_bound( fc::time_point_sec( 0 ) );
-      auto ex_up = old.upper_bound( now );
-      old.erase( ex_lo, ex_up );
-      g.unlock();
+      for( auto& s : local_txns ) {
+         fc::lock_guard g( s.mtx );
+         start_size += s.index.size();
+         auto& old = s.index.get<by_expiry>();
+         auto ex_lo = old.lower_bound( fc::time_point_sec( 0 ) );
+         auto ex_up = old.upper_bound( now );
+         old.erase( ex_lo, ex_up );
+         end_size += s.index.size();
+      }
 
       fc_dlog( logger, "expire_local_txns size ${s} removed ${r}", ("s", start_size)( "r", start_size - end_size ) );
    }
@@ -2604,9 +2739,11 @@ namespace eosio {
    void dispatch_manager::expire_blocks( uint32_t lib_num ) {
       unlinkable_block_cache.expire_blocks( lib_num );
 
-      fc::lock_guard g( blk_state_mtx );
-      auto& stale_blk = blk_state.get<by_connection_id>();
-      stale_blk.erase( stale_blk.lower_bound( 1 ), stale_blk.upper_bound( lib_num ) );
+      for( auto& s : blk_state ) {
+         fc::lock_guard g( s.mtx );
+         auto& stale_blk = s.index.get<by_connection_id>();
+         stale_blk.erase( stale_blk.lower_bound( 1 ), stale_blk.upper_bound( lib_num ) );
+      }
    }
 
    // thread safe
@@ -3105,8 +3242,18 @@ namespace eosio {
 
       auto ds = pending_message_buffer.create_datastream();
       fc::raw::unpack( ds, which );
+      // keep the serialized block so relay, block log and state history do not pack it again
+      const uint32_t which_size = fc::raw::pack_size( which );
+      EOS_ASSERT( message_length > which_size, block_validate_exception, "invalid block message length ${l}", ("l", message_length) );
+      auto packed = std::make_shared<bytes>( message_length - which_size );
+      ds.read( packed->data(), packed->size() );
       shared_ptr<signed_block> ptr = std::make_shared<signed_block>();
-      fc::raw::unpack( ds, *ptr );
+      fc::datastream<const char*> bds( packed->data(), packed->size() );
+      fc::raw::unpack( bds, *ptr );
+      // only canonical bytes can stand in for the packed block, e.g. a varint encoded with extra bytes unpacks the
+      // same but does not match what the block log and state history would otherwise write
+      if( bds.remaining() == 0 && fc::raw::pack_size( *ptr ) == packed->size() )
+         ptr->set_packed_block( std::move(packed) );
 
       auto is_webauthn_sig = []( const fc::crypto::signature& s ) {
          return s.which() == fc::get_index<fc::crypto::signature::storage_type, fc::crypto::webauthn::signature>();
@@ -3143,6 +3290,23 @@ namespace eosio {
          return true;
       }
 
+      // check for a duplicate before allocating and unpacking the transaction. The peeked id is the hash of the
+      // peer's bytes, which may not be the canonical packing, so it is only used to find a known transaction.
+      {
+         auto mb_peek_ds = pending_message_buffer.create_peek_datastream();
+         bounded_datastream peek_ds( mb_peek_ds, message_length );
+         unsigned_int which{};
+         fc::raw::unpack( peek_ds, which );
+         transaction_id_type peeked_id;
+         time_point_sec expiration;
+         if( peek_packed_transaction_id( peek_ds, peeked_id, expiration ) && my_impl->dispatcher.have_txn( peeked_id ) ) {
+            my_impl->dispatcher.add_peer_txn( peeked_id, expiration, connection_id );
+            peer_dlog( this, "got a duplicate transaction - dropping" );
+            pending_message_buffer.advance_read_ptr( message_length );
+            return true;
+         }
+      }
+
       const unsigned long trx_in_progress_sz = this->trx_in_progress_size.load();
 
       auto ds = pending_message_buffer.create_datastream();
@@ -3685,61 +3849,59 @@ namespace eosio {
    }
 
    // called from connection strand
+   // Block headers are validated on the strand of the connection that received them, so validation of blocks from
+   // different peers runs in parallel on the net threads. Linking into the fork database happens on the main thread.
    void connection::handle_message( const block_id_type& id, signed_block_ptr ptr ) {
-      // post to dispatcher strand so that we don't have multiple threads validating the block header
-      my_impl->dispatcher.strand.post([id, c{shared_from_this()}, ptr{std::move(ptr)}, cid=connection_id]() mutable {
-         controller& cc = my_impl->chain_plug->chain();
-
-         // may have come in on a different connection and posted into dispatcher strand before this one
-         if( my_impl->dispatcher.have_block( id ) || cc.fetch_block_state_by_id( id ) ) { // thread-safe
-            my_impl->dispatcher.add_peer_block( id, c->connection_id );
-            c->strand.post( [c, id]() {
-               my_impl->sync_master->sync_recv_block( c, id, block_header::num_from_id(id), false );
-            });
-            return;
-         }
+      controller& cc = my_impl->chain_plug->chain();
+      connection_ptr c = shared_from_this();
 
-         block_state_legacy_ptr bsp;
-         bool exception = false;
-         try {
-            // this may return null if block is not immediately ready to be processed
-            bsp = cc.create_block_state( id, ptr );
-         } catch( const fc::exception& ex ) {
-            exception = true;
-            fc_ilog( logger, "bad block exception connection ${cid}: #${n} ${id}...: ${m}",
-                     ("cid", cid)("n", ptr->block_num())("id", id.str().substr(8,16))("m",ex.to_string()));
-         } catch( ... ) {
-            exception = true;
-            fc_wlog( logger, "bad block connection ${cid}: #${n} ${id}...: unknown exception",
-                     ("cid", cid)("n", ptr->block_num())("id", id.str().substr(8,16)));
-         }
-         if( exception ) {
-            c->strand.post( [c, id, blk_num=ptr->block_num()]() {
-               my_impl->sync_master->rejected_block( c, blk_num );
-               my_impl->dispatcher.rejected_block( id );
-            });
-            return;
-         }
+      // may have come in on a different connection which has already validated it or is validating it now
+      if( my_impl->dispatcher.have_block( id ) || cc.fetch_block_state_by_id( id ) || // thread-safe
+          !my_impl->dispatcher.start_block_validation( id ) ) {
+         my_impl->dispatcher.add_peer_block( id, connection_id );
+         my_impl->sync_master->sync_recv_block( c, id, block_header::num_from_id(id), false );
+         return;
+      }
+      auto end_validation = fc::make_scoped_exit( [&id]() { my_impl->dispatcher.end_block_validation( id ); } );
 
+      block_state_legacy_ptr bsp;
+      bool exception = false;
+      try {
+         // this may return null if block is not immediately ready to be processed
+         bsp = cc.create_block_state( id, ptr );
+      } catch( const fc::exception& ex ) {
+         exception = true;
+         fc_ilog( logger, "bad block exception connection ${cid}: #${n} ${id}...: ${m}",
+                  ("cid", connection_id)("n", ptr->block_num())("id", id.str().substr(8,16))("m",ex.to_string()));
+      } catch( ... ) {
+         exception = true;
+         fc_wlog( logger, "bad block connection ${cid}: #${n} ${id}...: unknown exception",
+                  ("cid", connection_id)("n", ptr->block_num())("id", id.str().substr(8,16)));
+      }
+      if( exception ) {
+         my_impl->sync_master->rejected_block( c, ptr->block_num() );
+         my_impl->dispatcher.rejected_block( id );
+         return;
+      }
 
-         uint32_t block_num = bsp ? bsp->block_num : 0;
 
-         if( block_num != 0 ) {
-            fc_dlog( logger, "validated block header, broadcasting immediately, connection ${cid}, blk num = ${num}, id = ${id}",
-                     ("cid", cid)("num", block_num)("id", bsp->id) );
-            my_impl->dispatcher.add_peer_block( bsp->id, cid ); // no need to send back to sender
-            my_impl->dispatcher.bcast_block( bsp->block, bsp->id );
-         }
+      uint32_t block_num = bsp ? bsp->block_num : 0;
 
-         app().executor().post(priority::medium, exec_queue::read_write, [ptr{std::move(ptr)}, bsp{std::move(bsp)}, id, c{std::move(c)}]() mutable {
-            c->process_signed_block( id, std::move(ptr), std::move(bsp) );
-         });
+      if( block_num != 0 ) {
+         fc_dlog( logger, "validated block header, broadcasting immediately, connection ${cid}, blk num = ${num}, id = ${id}",
+                  ("cid", connection_id)("num", block_num)("id", bsp->id) );
+         my_impl->dispatcher.add_peer_block( bsp->id, connection_id ); // no need to send back to sender
+         my_impl->dispatcher.bcast_block( bsp->block, bsp->id );
+      }
 
-         if( block_num != 0 ) {
-            // ready to process immediately, so signal producer to interrupt start_block
-            my_impl->producer_plug->received_block(block_num);
-         }
+      app().executor().post(priority::medium, exec_queue::read_write, [ptr{std::move(ptr)}, bsp{std::move(bsp)}, id, c{std::move(c)}]() mutable {
+         c->process_signed_block( id, std::move(ptr), std::move(bsp) );
       });
+
+      if( block_num != 0 ) {
+         // ready to process immediately, so signal producer to interrupt start_block
+         my_impl->producer_plug->received_block(block_num);
+      }
    }
 
    // called from application thread
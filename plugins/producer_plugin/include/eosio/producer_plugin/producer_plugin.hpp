@@ -185,9 +185,44 @@ public:
       uint32_t head_block_num    = 0;
    };
 
+   // latency samples, in microseconds, of each stage of the block pipeline since the previous report
+   struct block_stage_metrics {
+      enum class stage : uint8_t {
+         start_block,
+         process_unapplied_trxs,
+         process_incoming_trxs,
+         recover_keys,
+         push_transaction,
+         finalize_block,
+         sign_block,
+         commit_block,
+         num_stages
+      };
+      static constexpr size_t num_stages = static_cast<size_t>(stage::num_stages);
+
+      static const char* stage_name(stage s) {
+         switch (s) {
+            case stage::start_block:            return "start_block";
+            case stage::process_unapplied_trxs: return "process_unapplied_trxs";
+            case stage::process_incoming_trxs:  return "process_incoming_trxs";
+            case stage::recover_keys:           return "recover_keys";
+            case stage::push_transaction:       return "push_transaction";
+            case stage::finalize_block:         return "finalize_block";
+            case stage::sign_block:             return "sign_block";
+            case stage::commit_block:           return "commit_block";
+            case stage::num_stages:             break;
+         }
+         return "unknown";
+      }
+
+      bool                                           produced = false;
+      std::array<std::vector<int64_t>, num_stages>   samples_us;
+   };
+
    void register_update_produced_block_metrics(std::function<void(produced_block_metrics)>&&);
    void register_update_speculative_block_metrics(std::function<void(speculative_block_metrics)>&&);
    void register_update_incoming_block_metrics(std::function<void(incoming_block_metrics)>&&);
+   void register_update_block_stage_metrics(std::function<void(block_stage_metrics)>&&);
 
    inline static bool test_mode_{false}; // to be moved into appbase (application_base)
 
@@ -356,6 +356,40 @@ struct block_time_tracker {
    bool paused = false;
 };
 
+// Collects per-stage latency samples of the block pipeline between reports. Only records while a metrics callback is
+// registered, the samples are handed off with the block metrics when a block is produced or aborted.
+struct block_stage_tracker {
+   using stage = producer_plugin::block_stage_metrics::stage;
+
+   void add(stage s, fc::microseconds dur) {
+      if (enabled)
+         pending.samples_us[static_cast<size_t>(s)].push_back(dur.count());
+   }
+
+   // records the time from now until the returned guard goes out of scope
+   auto time(stage s) {
+      return fc::make_scoped_exit([this, s, start = enabled ? fc::time_point::now() : fc::time_point{}]() {
+         if (enabled)
+            add(s, fc::time_point::now() - start);
+      });
+   }
+
+   producer_plugin::block_stage_metrics take(bool produced) {
+      producer_plugin::block_stage_metrics m = std::move(pending);
+      pending = {};
+      m.produced = produced;
+      return m;
+   }
+
+   // drops samples that belong to no block
+   void clear() {
+      pending = {};
+   }
+
+   bool                                 enabled = false;
+   producer_plugin::block_stage_metrics pending;
+};
+
 } // anonymous namespace
 
 class producer_plugin_impl : public std::enable_shared_from_this<producer_plugin_impl> {
@@ -518,6 +552,7 @@ public:
 
    account_failures                 _account_fails;
    block_time_tracker               _time_tracker;
+   block_stage_tracker              _stage_tracker;
 
    std::optional<scoped_connection> _accepted_block_connection;
    std::optional<scoped_connection> _accepted_block_header_connection;
@@ -545,6 +580,7 @@ public:
    std::function<void(producer_plugin::produced_block_metrics)> _update_produced_block_metrics;
    std::function<void(producer_plugin::speculative_block_metrics)> _update_speculative_block_metrics;
    std::function<void(producer_plugin::incoming_block_metrics)> _update_incoming_block_metrics;
+   std::function<void(producer_plugin::block_stage_metrics)> _update_block_stage_metrics;
 
    // ro for read-only
    struct ro_trx_t {
@@ -659,8 +695,11 @@ public:
          _time_tracker.report(block_num, block_producer, metrics);
          if (_update_speculative_block_metrics)
             _update_speculative_block_metrics(metrics);
+         if (_update_block_stage_metrics)
+            _update_block_stage_metrics(_stage_tracker.take(false));
       }
       _time_tracker.clear();
+      _stage_tracker.clear();
    }
 
    bool on_incoming_block(const signed_block_ptr& block, const std::optional<block_id_type>& block_id, const block_state_legacy_ptr& bsp) {
@@ -713,7 +752,7 @@ public:
             br,
             bspr,
             [this](const branch_type& forked_branch) { _unapplied_transactions.add_forked(forked_branch); },
-            [this](const transaction_id_type& id) { return _unapplied_transactions.get_trx(id); });
+            [this](const transaction_id_type& id) { return _unapplied_transactions.find_trx_meta(id); });
       } catch (const guard_exception& e) {
          chain_plugin::handle_guard_exception(e);
          return false;
@@ -821,6 +860,7 @@ public:
 
                  chain::controller& chain = chain_plug->chain();
                  transaction_metadata_ptr trx_meta;
+                 const auto recover_start = fc::time_point::now();
                  try {
                     trx_meta = transaction_metadata::recover_keys(trx, chain.get_chain_id(), time_limit, trx_type,
                                                                   chain.configured_subjective_signature_length_limit());
@@ -847,7 +887,9 @@ public:
                  // key recovery complete, continue execution on the main thread
                  app().executor().post(
                          priority::low, exec_queue::read_write,
-                         [this, trx_meta{std::move(trx_meta)}, is_transient, next{std::move(next)}, api_trx, return_failure_traces]() {
+                         [this, trx_meta{std::move(trx_meta)}, is_transient, next{std::move(next)}, api_trx, return_failure_traces,
+                          recover_time{fc::time_point::now() - recover_start}]() {
+                            _stage_tracker.add(block_stage_tracker::stage::recover_keys, recover_time);
                             auto start       = fc::time_point::now();
                             auto idle_time   = _time_tracker.add_idle_time(start);
                             auto trx_tracker = _time_tracker.start_trx(is_transient, start);
@@ -1963,8 +2005,11 @@ producer_plugin_impl::start_block_result producer_plugin_impl::start_block() {
          auto incoming_itr = _unapplied_transactions.incoming_begin();
 
          if (in_producing_mode()) {
-            if (!process_unapplied_trxs(preprocess_deadline))
-               return start_block_result::exhausted;
+            {
+               auto stage_timer = _stage_tracker.time(block_stage_tracker::stage::process_unapplied_trxs);
+               if (!process_unapplied_trxs(preprocess_deadline))
+                  return start_block_result::exhausted;
+            }
 
             // after DISABLE_DEFERRED_TRXS_STAGE_2 is activated,
             // no deferred trxs are allowed to be retired
@@ -1985,8 +2030,11 @@ producer_plugin_impl::start_block_result producer_plugin_impl::start_block() {
             return start_block_result::exhausted;
          }
 
-         if (!process_incoming_trxs(preprocess_deadline, incoming_itr))
-            return start_block_result::exhausted;
+         {
+            auto stage_timer = _stage_tracker.time(block_stage_tracker::stage::process_incoming_trxs);
+            if (!process_incoming_trxs(preprocess_deadline, incoming_itr))
+               return start_block_result::exhausted;
+         }
 
          return start_block_result::succeeded;
 
@@ -2147,6 +2195,7 @@ producer_plugin_impl::push_result producer_plugin_impl::push_transaction(const f
                                                                          block_time_tracker::trx_time_tracker&       trx_tracker,
                                                                          const next_function<transaction_trace_ptr>& next) {
    auto start = fc::time_point::now();
+   auto stage_timer = _stage_tracker.time(block_stage_tracker::stage::push_transaction);
    EOS_ASSERT(!trx->is_read_only(), producer_exception, "Unexpected read-only trx");
 
    chain::controller&         chain           = chain_plug->chain();
@@ -2467,7 +2516,15 @@ bool producer_plugin_impl::block_is_exhausted() const {
 void producer_plugin_impl::schedule_production_loop() {
    _timer.cancel();
 
-   auto result = start_block();
+   auto result = [&]() {
+      auto stage_timer = _stage_tracker.time(block_stage_tracker::stage::start_block);
+      return start_block();
+   }();
+
+   if (!chain_plug->chain().is_building_block()) {
+      // no block to report the start_block samples with, e.g. start_block failed or is waiting
+      _stage_tracker.clear();
+   }
 
    if (result == start_block_result::failed) {
       elog("Failed to start a pending block, will try again later");
@@ -2634,8 +2691,11 @@ void producer_plugin_impl::produce_block() {
 
    // idump( (fc::time_point::now() - chain.pending_block_time()) );
    controller::block_report br;
+   fc::microseconds sign_time;
+   auto finalize_start = fc::time_point::now();
    chain.finalize_block(br, [&](const digest_type& d) {
       auto                   debug_logger = maybe_make_debug_time_logger();
+      auto                   sign_start   = fc::time_point::now();
       vector<signature_type> sigs;
       sigs.reserve(relevant_providers.size());
 
@@ -2643,10 +2703,16 @@ void producer_plugin_impl::produce_block() {
       for (const auto& p : relevant_providers) {
          sigs.emplace_back(p.get()(d));
       }
+      sign_time = fc::time_point::now() - sign_start;
       return sigs;
    });
+   _stage_tracker.add(block_stage_tracker::stage::finalize_block, fc::time_point::now() - finalize_start - sign_time);
+   _stage_tracker.add(block_stage_tracker::stage::sign_block, sign_time);
 
-   chain.commit_block();
+   {
+      auto stage_timer = _stage_tracker.time(block_stage_tracker::stage::commit_block);
+      chain.commit_block();
+   }
 
    block_state_legacy_ptr new_bs = chain.head_block_state();
    producer_plugin::produced_block_metrics metrics;
@@ -2675,6 +2741,9 @@ void producer_plugin_impl::produce_block() {
       metrics.head_block_num = chain.head_block_num();
       _update_produced_block_metrics(metrics);
    }
+   if (_update_block_stage_metrics) {
+      _update_block_stage_metrics(_stage_tracker.take(true));
+   }
 }
 
 void producer_plugin::received_block(uint32_t block_num) {
@@ -2901,4 +2970,9 @@ void producer_plugin::register_update_incoming_block_metrics(std::function<void(
    my->_update_incoming_block_metrics = std::move(fun);
 }
 
+void producer_plugin::register_update_block_stage_metrics(std::function<void(producer_plugin::block_stage_metrics)>&& fun) {
+   my->_stage_tracker.enabled = !!fun;
+   my->_update_block_stage_metrics = std::move(fun);
+}
+
 } // namespace eosio
@@ -0,0 +1,110 @@
+#include <eosio/producer_plugin/producer_plugin.hpp>
+#include <eosio/testing/tester.hpp>
+#include <boost/test/unit_test.hpp>
+
+namespace eosio::test::detail {
+using namespace eosio::chain::literals;
+struct testit {
+   uint64_t id;
+
+   testit( uint64_t id = 0 ) :id(id){}
+
+   static account_name get_account() {
+      return chain::config::system_account_name;
+   }
+
+   static action_name get_name() {
+      return "testit"_n;
+   }
+};
+}
+FC_REFLECT( eosio::test::detail::testit, (id) )
+
+namespace {
+
+using namespace eosio;
+using namespace eosio::chain;
+using namespace eosio::test::detail;
+
+auto make_trx( const chain_id_type& chain_id, uint64_t id ) {
+   account_name creator = config::system_account_name;
+
+   signed_transaction trx;
+   trx.expiration = fc::time_point_sec{fc::time_point::now() + fc::seconds( 60 )};
+   trx.actions.emplace_back( vector<permission_level>{{creator, config::active_name}}, testit{id} );
+   auto priv_key = private_key_type::regenerate<fc::ecc::private_key_shim>(fc::sha256::hash(std::string("nathan")));
+   trx.sign( priv_key, chain_id );
+
+   return std::make_shared<packed_transaction>( std::move(trx) );
+}
+}
+
+BOOST_AUTO_TEST_SUITE(block_stage_metrics_test)
+
+// Verifies that a produced block reports latency samples for each stage of the block pipeline
+BOOST_AUTO_TEST_CASE(produced_block_stages) {
+   using namespace std::chrono_literals;
+   using stage = producer_plugin::block_stage_metrics::stage;
+   fc::temp_directory temp;
+   appbase::scoped_app app;
+   auto temp_dir_str = temp.path().string();
+
+   // first produced block that included transactions, set on the main thread
+   std::promise<producer_plugin::block_stage_metrics> metrics_promise;
+   std::future<producer_plugin::block_stage_metrics> metrics_fut = metrics_promise.get_future();
+   bool metrics_set = false;
+
+   std::promise<chain_plugin*> plugin_promise;
+   std::future<chain_plugin*> plugin_fut = plugin_promise.get_future();
+   std::thread app_thread( [&]() {
+      try {
+         std::vector<const char*> argv =
+            {"test", "--data-dir", temp_dir_str.c_str(), "--config-dir", temp_dir_str.c_str(),
+               "-p", "eosio", "-e", "--disable-subjective-p2p-billing=true" };
+         app->initialize<chain_plugin, producer_plugin>( argv.size(), (char**) &argv[0] );
+         app->find_plugin<producer_plugin>()->register_update_block_stage_metrics(
+            [&](producer_plugin::block_stage_metrics m) {
+               if( !metrics_set && m.produced && !m.samples_us[static_cast<size_t>(stage::push_transaction)].empty() ) {
+                  metrics_set = true;
+                  metrics_promise.set_value( std::move(m) );
+               }
+            } );
+         app->startup();
+         plugin_promise.set_value( app->find_plugin<chain_plugin>() );
+         app->exec();
+         return;
+      } FC_LOG_AND_DROP()
+      BOOST_CHECK(!"app threw exception see logged error");
+   } );
+
+   auto chain_plug = plugin_fut.get();
+   auto chain_id = chain_plug->get_chain_id();
+
+   for( uint64_t i = 1; i <= 10; ++i ) {
+      auto ptrx = make_trx( chain_id, i );
+      app->post( priority::low, [ptrx, &app]() {
+         app->get_method<plugin_interface::incoming::methods::transaction_async>()(ptrx,
+            false,
+            transaction_metadata::trx_type::input,
+            true,
+            [](const next_function_variant<transaction_trace_ptr>&) {} );
+      });
+   }
+
+   BOOST_REQUIRE( metrics_fut.wait_for( 10s ) == std::future_status::ready );
+   auto metrics = metrics_fut.get();
+   // stages every produced block goes through, the others depend on how the trxs arrived relative to the block
+   for( auto s : { stage::start_block, stage::push_transaction, stage::finalize_block, stage::sign_block, stage::commit_block } ) {
+      BOOST_TEST_INFO( producer_plugin::block_stage_metrics::stage_name(s) );
+      BOOST_CHECK( !metrics.samples_us[static_cast<size_t>(s)].empty() );
+   }
+   for( const auto& samples : metrics.samples_us ) {
+      for( auto us : samples )
+         BOOST_CHECK( us >= 0 );
+   }
+
+   app->quit();
+   app_thread.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -7,6 +7,7 @@
 #include <prometheus/counter.h>
 #include <prometheus/info.h>
 #include <prometheus/registry.h>
+#include <prometheus/summary.h>
 #include <prometheus/text_serializer.h>
 #include <fc/log/logger.hpp>
 namespace eosio::metrics {
@@ -15,6 +16,9 @@ struct catalog_type {
 
    using Gauge   = prometheus::Gauge;
    using Counter = prometheus::Counter;
+   using Summary = prometheus::Summary;
+   using stage   = producer_plugin::block_stage_metrics::stage;
+   static constexpr size_t num_stages = producer_plugin::block_stage_metrics::num_stages;
 
    template <typename T>
    prometheus::Family<T>& family(const std::string& name, const std::string& help) {
@@ -108,6 +112,16 @@ struct catalog_type {
    Counter& latency_us_incoming_block;
    Counter& blocks_incoming;
 
+   // block pipeline stages, p50/p99 over a sliding window and the max of the last reported block
+   struct block_stage_latency_metrics {
+      std::array<Summary*, num_stages> latency_us{};
+      std::array<Gauge*, num_stages>   max_us{};
+   };
+   prometheus::Family<Summary>& block_stage_latency_us;
+   prometheus::Family<Gauge>&   block_stage_max_us;
+   block_stage_latency_metrics  produced_stage_metrics;
+   block_stage_latency_metrics  speculative_stage_metrics;
+
    // prometheus exporter
    Counter& bytes_transferred;
    Counter& num_scrapes;
@@ -184,10 +198,25 @@ struct catalog_type {
        , net_usage_us_incoming_block(net_usage_us.Add({{"block_type", "incoming"}}))
        , latency_us_incoming_block(build<Counter>("nodeos_incoming_us_block_latency", "total incoming block latency"))
        , blocks_incoming(build<Counter>("nodeos_blocks_incoming", "number of incoming blocks"))
+       , block_stage_latency_us(family<Summary>("nodeos_block_stage_latency_us", "latency in microseconds of each block pipeline stage"))
+       , block_stage_max_us(family<Gauge>("nodeos_block_stage_max_us", "max latency in microseconds of each block pipeline stage in the last block"))
+       , produced_stage_metrics(make_stage_metrics("produced"))
+       , speculative_stage_metrics(make_stage_metrics("speculative"))
        , bytes_transferred(build<Counter>("exposer_transferred_bytes_total",
                                           "total number of bytes for responses to prometheus scrape requests"))
        , num_scrapes(build<Counter>("exposer_scrapes_total", "total number of prometheus scrape requests received")) {}
 
+   block_stage_latency_metrics make_stage_metrics(const std::string& block_type) {
+      block_stage_latency_metrics m;
+      for (size_t i = 0; i < num_stages; ++i) {
+         const prometheus::Labels labels{{"stage", producer_plugin::block_stage_metrics::stage_name(static_cast<stage>(i))},
+                                         {"block_type", block_type}};
+         m.latency_us[i] = &block_stage_latency_us.Add(labels, Summary::Quantiles{{0.5, 0.05}, {0.99, 0.001}});
+         m.max_us[i]     = &block_stage_max_us.Add(labels);
+      }
+      return m;
+   }
+
    std::string report() {
       const prometheus::TextSerializer serializer;
       auto                             result = serializer.Serialize(registry.Collect());
@@ -281,6 +310,19 @@ struct catalog_type {
       head_block_num.Set(metrics.head_block_num);
    }
 
+   void update(const producer_plugin::block_stage_metrics& metrics) {
+      auto& stage_metrics = metrics.produced ? produced_stage_metrics : speculative_stage_metrics;
+      for (size_t i = 0; i < num_stages; ++i) {
+         const auto& samples = metrics.samples_us[i];
+         int64_t     max_us  = 0;
+         for (int64_t us : samples) {
+            stage_metrics.latency_us[i]->Observe(us);
+            max_us = std::max(max_us, us);
+         }
+         stage_metrics.max_us[i]->Set(max_us);
+      }
+   }
+
    void update_prometheus_info() {
       info_details = info.Add({
             {"server_version", chain_apis::itoh(static_cast<uint32_t>(app().version()))},
@@ -323,6 +365,10 @@ struct catalog_type {
           [&strand, this](const producer_plugin::incoming_block_metrics& metrics) {
              strand.post([metrics, this]() { update(metrics); });
           });
+      producer.register_update_block_stage_metrics(
+          [&strand, this](producer_plugin::block_stage_metrics&& metrics) {
+             strand.post([metrics = std::move(metrics), this]() { update(metrics); });
+          });
    }
 };
 
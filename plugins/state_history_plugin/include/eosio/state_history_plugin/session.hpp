@@ -5,10 +5,12 @@
 #include <eosio/state_history/types.hpp>
 
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/beast/websocket.hpp>
+#include <deque>
 #include <memory>
 
 
@@ -30,6 +32,10 @@ struct session_base {
 
    std::optional<state_history::get_blocks_request_v0> current_request;
    bool need_to_send_update = false;
+
+   // managed by session_manager
+   std::deque<std::unique_ptr<send_queue_entry_base>> send_queue;
+   bool sending = false;
 };
 
 class send_update_send_queue_entry : public send_queue_entry_base {
@@ -51,8 +57,8 @@ public:
    }
 };
 
-/// Coordinate sending of queued entries. Only one session can read from the ship logs at a time so coordinate
-/// their execution on the ship thread.
+/// Coordinate sending of queued entries. Each session has its own send queue and sends one entry at a time; sessions
+/// read the ship logs concurrently so a slow client does not hold up the others.
 /// accessed from ship thread
 class session_manager {
 private:
@@ -60,8 +66,6 @@ private:
 
    boost::asio::io_context& ship_io_context;
    std::set<std::shared_ptr<session_base>> session_set;
-   bool sending  = false;
-   std::deque<std::pair<std::shared_ptr<session_base>, entry_ptr>> send_queue;
 
 public:
    explicit session_manager(boost::asio::io_context& ship_io_context)
@@ -74,7 +78,9 @@ public:
    void remove(const std::shared_ptr<session_base>& s, bool active_entry) {
       session_set.erase( s );
       if (active_entry)
-         pop_entry();
+         pop_entry(s);
+      else if (!s->sending)
+         s->send_queue.clear();
    }
 
    bool is_active(const std::shared_ptr<session_base>& s) {
@@ -82,48 +88,39 @@ public:
    }
 
    void add_send_queue(std::shared_ptr<session_base> s, entry_ptr p) {
-      send_queue.emplace_back(std::move(s), std::move(p));
-      send();
+      s->send_queue.emplace_back(std::move(p));
+      send(s);
    }
 
-   void send() {
-      if (sending)
+   void send(const std::shared_ptr<session_base>& s) {
+      if (s->sending)
          return;
-      if (send_queue.empty()) {
-         send_updates();
+      if (!is_active(s)) {
+         // entries hold the session, release them once the session is removed
+         s->send_queue.clear();
          return;
       }
-      while (!send_queue.empty() && !is_active(send_queue[0].first)) {
-         send_queue.erase(send_queue.begin());
+      if (s->send_queue.empty()) {
+         if (s->need_to_send_update)
+            add_send_queue(s, std::make_unique<send_update_send_queue_entry>(s, nullptr, chain::block_id_type{}));
+         return;
       }
 
-      if (!send_queue.empty()) {
-         sending = true;
-         send_queue[0].second->send_entry();
-      } else {
-         send();
-      }
+      s->sending = true;
+      s->send_queue.front()->send_entry();
    }
 
-   void pop_entry(bool call_send = true) {
-      send_queue.erase(send_queue.begin());
-      sending = false;
-      if (call_send || !send_queue.empty()) {
+   void pop_entry(const std::shared_ptr<session_base>& s, bool call_send = true) {
+      s->send_queue.pop_front();
+      s->sending = false;
+      if (call_send || !s->send_queue.empty()) {
          // avoid blowing the stack
-         boost::asio::post(ship_io_context, [this]() {
-            send();
+         boost::asio::post(ship_io_context, [this, s]() {
+            send(s);
          });
       }
    }
 
-   void send_updates() {
-      for( auto& s : session_set ) {
-         if (s->need_to_send_update ) {
-            add_send_queue(s, std::make_unique<send_update_send_queue_entry>(s, nullptr, chain::block_id_type{}));
-         }
-      }
-   }
-
    void send_update(const chain::signed_block_ptr& block, const chain::block_id_type& id) {
       for( auto& s : session_set ) {
          add_send_queue(s, std::make_unique<send_update_send_queue_entry>(s, block, id));
@@ -148,7 +145,7 @@ public:
       session->socket_stream->async_write(boost::asio::buffer(data),
                                    [s{session}](boost::system::error_code ec, size_t) {
                                       s->callback(ec, true, "async_write", [s] {
-                                         s->session_mgr.pop_entry();
+                                         s->session_mgr.pop_entry(s);
                                       });
                                    });
    }
@@ -192,6 +189,9 @@ class blocks_result_send_queue_entry : public send_queue_entry_base, public std:
    state_history::get_blocks_result_v0                             r;
    std::vector<char>                                               data;
    std::optional<locked_decompress_stream>                         stream;
+   std::optional<boost::asio::steady_timer>                        retry_timer;
+
+   static constexpr auto log_busy_retry_interval = std::chrono::milliseconds(10);
 
    template <typename Next>
    void async_send(bool fin, const std::vector<char>& d, Next&& next) {
@@ -259,17 +259,38 @@ class blocks_result_send_queue_entry : public send_queue_entry_base, public std:
                 });
    }
 
+   // the log is waiting to truncate, try again later without blocking the ship thread
+   template <typename Retry>
+   void retry_later(Retry&& retry) {
+      retry_timer.emplace(session->socket_stream->get_executor(), log_busy_retry_interval);
+      retry_timer->async_wait([me=this->shared_from_this(), retry = std::forward<Retry>(retry)](boost::system::error_code ec) mutable {
+         me->session->callback(ec, true, "async_wait", [retry = std::move(retry)]() mutable {
+            retry();
+         });
+      });
+   }
+
    void send_deltas() {
       stream.reset();
-      send_log(session->get_delta_log_entry(r, stream), true, [me=this->shared_from_this()]() {
+      auto entry_size = session->get_delta_log_entry(r, stream);
+      if (!entry_size) {
+         retry_later([me=this->shared_from_this()]() { me->send_deltas(); });
+         return;
+      }
+      send_log(*entry_size, true, [me=this->shared_from_this()]() {
          me->stream.reset();
-         me->session->session_mgr.pop_entry();
+         me->session->session_mgr.pop_entry(me->session);
       });
    }
 
    void send_traces() {
       stream.reset();
-      send_log(session->get_trace_log_entry(r, stream), false, [me=this->shared_from_this()]() {
+      auto entry_size = session->get_trace_log_entry(r, stream);
+      if (!entry_size) {
+         retry_later([me=this->shared_from_this()]() { me->send_traces(); });
+         return;
+      }
+      send_log(*entry_size, false, [me=this->shared_from_this()]() {
          me->send_deltas();
       });
    }
@@ -379,26 +400,33 @@ private:
       }
    }
 
-   uint64_t get_trace_log_entry(const eosio::state_history::get_blocks_result_v0& result,
-                                std::optional<locked_decompress_stream>& buf) {
+   /// @return the decompressed entry size, or empty if the log is busy and the read should be retried
+   static std::optional<uint64_t> get_log_entry(std::optional<state_history_log>& optional_log, uint32_t block_num,
+                                                std::optional<locked_decompress_stream>& buf) {
+      buf.emplace( optional_log->create_locked_decompress_stream(std::try_to_lock) );
+      if (!buf->lock.owns_lock()) {
+         buf.reset();
+         return {};
+      }
+      return optional_log->get_unpacked_entry( block_num, *buf );
+   }
+
+   std::optional<uint64_t> get_trace_log_entry(const eosio::state_history::get_blocks_result_v0& result,
+                                               std::optional<locked_decompress_stream>& buf) {
       if (result.traces.has_value()) {
          auto& optional_log = plugin.get_trace_log();
-         if( optional_log ) {
-            buf.emplace( optional_log->create_locked_decompress_stream() );
-            return optional_log->get_unpacked_entry( result.this_block->block_num, *buf );
-         }
+         if( optional_log )
+            return get_log_entry( optional_log, result.this_block->block_num, buf );
       }
       return 0;
    }
 
-   uint64_t get_delta_log_entry(const eosio::state_history::get_blocks_result_v0& result,
-                                std::optional<locked_decompress_stream>& buf) {
+   std::optional<uint64_t> get_delta_log_entry(const eosio::state_history::get_blocks_result_v0& result,
+                                               std::optional<locked_decompress_stream>& buf) {
       if (result.deltas.has_value()) {
          auto& optional_log = plugin.get_chain_state_log();
-         if( optional_log ) {
-            buf.emplace( optional_log->create_locked_decompress_stream() );
-            return optional_log->get_unpacked_entry( result.this_block->block_num, *buf );
-         }
+         if( optional_log )
+            return get_log_entry( optional_log, result.this_block->block_num, buf );
       }
       return 0;
    }
@@ -485,7 +513,7 @@ private:
    void send_update(state_history::get_blocks_result_v0 result, const chain::signed_block_ptr& block, const chain::block_id_type& id) {
       need_to_send_update = true;
       if (!current_request || !current_request->max_messages_in_flight) {
-         session_mgr.pop_entry(false);
+         session_mgr.pop_entry(this->shared_from_this(), false);
          return;
       }
 
@@ -496,7 +524,7 @@ private:
       if (to_send_block_num > current || to_send_block_num >= current_request->end_block_num) {
          fc_dlog( plugin.get_logger(), "Not sending, to_send_block_num: ${s}, current: ${c} current_request.end_block_num: ${b}",
                   ("s", to_send_block_num)("c", current)("b", current_request->end_block_num) );
-         session_mgr.pop_entry(false);
+         session_mgr.pop_entry(this->shared_from_this(), false);
          return;
       }
 
@@ -517,7 +545,7 @@ private:
 
          if(block_id_seen_by_client == *block_id) {
             ++to_send_block_num;
-            session_mgr.pop_entry(false);
+            session_mgr.pop_entry(this->shared_from_this(), false);
             return;
          }
       }
@@ -559,7 +587,7 @@ private:
 
    void send_update(const chain::signed_block_ptr& block, const chain::block_id_type& id) override {
       if (!current_request || !current_request->max_messages_in_flight) {
-         session_mgr.pop_entry(false);
+         session_mgr.pop_entry(this->shared_from_this(), false);
          return;
       }
 
@@ -576,7 +604,7 @@ private:
          result.head = plugin.get_block_head();
          send_update(std::move(result), nullptr, chain::block_id_type{});
       } else {
-         session_mgr.pop_entry(false);
+         session_mgr.pop_entry(this->shared_from_this(), false);
       }
    }
 
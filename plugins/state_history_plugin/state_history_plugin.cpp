@@ -110,7 +110,7 @@ public:
    void get_block(uint32_t block_num, uint32_t block_state_block_num, const signed_block_ptr& block, std::optional<bytes>& result) const {
       auto p = get_block(block_num, block_state_block_num, block);
       if (p)
-         result = fc::raw::pack(*p);
+         result = *p->packed_block();
    }
 
    // thread-safe
@@ -308,6 +308,14 @@ void state_history_plugin::set_program_options(options_description& cli, options
    options("state-history-unix-socket-path", bpo::value<string>(),
            "the path (relative to data-dir) to create a unix socket upon which to listen for incoming connections.");
    options("trace-history-debug-mode", bpo::bool_switch()->default_value(false), "enable debug mode for trace history");
+   options("state-history-compression", bpo::value<string>()->default_value("zlib"),
+           "compression of new state history log entries, zlib or zstd. Existing entries are read with whichever compression\n"
+           "they were written with.\n"
+           "With zstd, a dictionary (e.g. trained with 'zstd --train' on sample entries) placed next to a log as\n"
+           "'trace_history.zdict' or 'chain_state_history.zdict' is used for that log. Do not replace or remove a dictionary\n"
+           "while the log has entries compressed with it, they can no longer be read.");
+   options("state-history-zstd-level", bpo::value<int>()->default_value(state_history::zstd_compressor::default_compression_level),
+           "zstd compression level of state history log entries");
 
    if(cfile::supports_hole_punching())
       options("state-history-log-retain-blocks", bpo::value<uint32_t>(), "if set, periodically prune the state history files to store only configured number of most recent blocks");
@@ -389,10 +397,14 @@ void state_history_plugin_impl::plugin_initialize(const variables_map& options)
             config.max_retained_files = options.at("max-retained-history-files").as<uint32_t>();
       }
 
+      state_history::compression_config compression_conf;
+      compression_conf.type       = state_history::to_compression_type(options.at("state-history-compression").as<string>());
+      compression_conf.zstd_level = options.at("state-history-zstd-level").as<int>();
+
       if (options.at("trace-history").as<bool>())
-         trace_log.emplace("trace_history", state_history_dir , ship_log_conf);
+         trace_log.emplace("trace_history", state_history_dir , ship_log_conf, compression_conf);
       if (options.at("chain-state-history").as<bool>())
-         chain_state_log.emplace("chain_state_history", state_history_dir, ship_log_conf);
+         chain_state_log.emplace("chain_state_history", state_history_dir, ship_log_conf, compression_conf);
    }
    FC_LOG_AND_RETHROW()
 } // state_history_plugin::plugin_initialize
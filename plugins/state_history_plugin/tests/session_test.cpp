@@ -8,6 +8,7 @@
 #include <cstdlib>
 #include <deque>
 #include <functional>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <random>
@@ -326,9 +327,10 @@ struct state_history_test_fixture {
    ~state_history_test_fixture() { ws.close(websocket::close_code::normal); }
 };
 
-void store_read_test_case(uint64_t data_size, eosio::state_history_log_config config) {
+void store_read_test_case(uint64_t data_size, eosio::state_history_log_config config,
+                          eosio::state_history::compression_config compression = {}) {
    fc::temp_directory       log_dir;
-   eosio::state_history_log log("ship", log_dir.path(), config);
+   eosio::state_history_log log("ship", log_dir.path(), config, compression);
 
 
    eosio::state_history_log_header header;
@@ -356,6 +358,14 @@ void store_read_test_case(uint64_t data_size, eosio::state_history_log_config co
 
    BOOST_CHECK_EQUAL(data.size() * sizeof(data[0]), decompressed.size());
    BOOST_CHECK(std::equal(decompressed.begin(), decompressed.end(), (const char*)data.data()));
+
+   eosio::state_history_log_header first_header;
+   log.get_log_file().seek(0);
+   fc::raw::unpack(log.get_log_file(), first_header);
+   BOOST_CHECK_EQUAL(eosio::is_ship_entry_zstd(first_header.magic),
+                     compression.type == eosio::state_history::compression_type::zstd);
+   BOOST_CHECK_EQUAL(eosio::is_ship_log_pruned(first_header.magic),
+                     std::holds_alternative<eosio::state_history::prune_config>(config));
 }
 
 BOOST_AUTO_TEST_CASE(store_read_entry_no_prune) {
@@ -371,6 +381,63 @@ BOOST_AUTO_TEST_CASE(store_read_entry_prune_enabled) {
    store_read_test_case(1024, eosio::state_history::prune_config{.prune_blocks = 100});
 }
 
+BOOST_AUTO_TEST_CASE(store_read_entry_zstd) {
+   store_read_test_case(1024, {}, {.type = eosio::state_history::compression_type::zstd});
+}
+
+BOOST_AUTO_TEST_CASE(store_read_entry_zstd_prune_enabled) {
+   store_read_test_case(1024, eosio::state_history::prune_config{.prune_blocks = 100},
+                        {.type = eosio::state_history::compression_type::zstd});
+}
+
+BOOST_AUTO_TEST_CASE(store_read_mixed_compression_with_dictionary) {
+   fc::temp_directory log_dir;
+   auto               data = generate_data(1024);
+   const size_t       data_bytes = data.size() * sizeof(data[0]);
+
+   auto write_block = [&](eosio::state_history_log& log, uint32_t block_num) {
+      eosio::state_history_log_header header;
+      header.block_id = block_id_for(block_num);
+      log.pack_and_write_entry(header, block_id_for(block_num - 1),
+                               [&](auto&& buf) { bio::write(buf, (const char*)data.data(), data_bytes); });
+   };
+
+   auto read_block = [&](eosio::state_history_log& log, uint32_t block_num) {
+      auto buf = log.create_locked_decompress_stream();
+      BOOST_REQUIRE_EQUAL(log.get_unpacked_entry(block_num, buf), data_bytes);
+      std::vector<char> decompressed;
+      bio::copy(*std::get<std::unique_ptr<bio::filtering_istreambuf>>(buf.buf), bio::back_inserter(decompressed));
+      return decompressed.size() == data_bytes && std::equal(decompressed.begin(), decompressed.end(), (const char*)data.data());
+   };
+
+   {
+      eosio::state_history_log log("ship", log_dir.path(), {});
+      write_block(log, 1);
+   }
+
+   // a raw content dictionary which matches the entries well
+   {
+      std::ofstream dict(log_dir.path() / "ship.zdict", std::ios::binary);
+      dict.write((const char*)data.data(), data_bytes / 2);
+   }
+
+   {
+      eosio::state_history_log log("ship", log_dir.path(), {}, {.type = eosio::state_history::compression_type::zstd});
+      write_block(log, 2);
+      write_block(log, 3);
+
+      BOOST_CHECK(read_block(log, 1));
+      BOOST_CHECK(read_block(log, 2));
+      BOOST_CHECK(read_block(log, 3));
+   }
+
+   // zlib again, the zstd entries are still readable
+   eosio::state_history_log log("ship", log_dir.path(), {});
+   write_block(log, 4);
+   for (uint32_t block_num = 1; block_num <= 4; ++block_num)
+      BOOST_CHECK(read_block(log, block_num));
+}
+
 BOOST_AUTO_TEST_CASE(store_with_existing) {
    uint64_t data_size = 512;
    fc::temp_directory       log_dir;
@@ -399,6 +466,95 @@ BOOST_AUTO_TEST_CASE(store_with_existing) {
    );
 }
 
+BOOST_AUTO_TEST_CASE(prune_deferred_while_reading) {
+   fc::temp_directory log_dir;
+   const eosio::state_history::prune_config prune_conf{.prune_blocks = 2, .prune_threshold = 4 * 1024};
+   auto data = generate_data(4096);
+   std::optional<eosio::state_history_log> log;
+   log.emplace("ship", log_dir.path(), prune_conf);
+
+   auto write_block = [&](uint32_t block_num) {
+      eosio::state_history_log_header header;
+      header.block_id = block_id_for(block_num);
+      log->pack_and_write_entry(header, block_id_for(block_num - 1),
+                                [&](auto&& buf) { bio::write(buf, (const char*)data.data(), data.size() * sizeof(data[0])); });
+   };
+
+   write_block(1);
+   {
+      // a reader holding the log defers pruning, appends still go through and the log stays readable
+      auto strm = log->create_locked_decompress_stream();
+      for (uint32_t block_num = 2; block_num <= 10; ++block_num)
+         write_block(block_num);
+      BOOST_CHECK_EQUAL(log->block_range().first, 1u);
+      BOOST_CHECK(log->get_block_id(1) == block_id_for(1));
+      BOOST_CHECK(log->get_block_id(10) == block_id_for(10));
+   }
+
+   // pruned on the next write once the reader is gone
+   write_block(11);
+   BOOST_CHECK_EQUAL(log->block_range().first, 10u);
+   BOOST_CHECK_EQUAL(log->block_range().second, 12u);
+
+   // trailing block count was updated, reopening finds the same range
+   log.reset();
+   log.emplace("ship", log_dir.path(), prune_conf);
+   BOOST_CHECK_EQUAL(log->block_range().first, 10u);
+   BOOST_CHECK_EQUAL(log->block_range().second, 12u);
+   BOOST_CHECK(log->get_block_id(11) == block_id_for(11));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_read_streams) {
+   fc::temp_directory       log_dir;
+   eosio::state_history_log log("ship", log_dir.path(), {});
+   auto                     data = generate_data(512);
+
+   auto write_block = [&](uint32_t block_num, const std::string& nonce = {}) {
+      eosio::state_history_log_header header;
+      header.block_id = block_id_for(block_num, nonce);
+      log.pack_and_write_entry(header, block_id_for(block_num - 1),
+                               [&](auto&& buf) { bio::write(buf, (const char*)data.data(), data.size() * sizeof(data[0])); });
+   };
+   auto read_all = [](eosio::locked_decompress_stream& strm) {
+      std::vector<char> decompressed;
+      std::visit(eosio::chain::overloaded{ [&](std::vector<char>& bytes) { decompressed = bytes; },
+                                           [&](std::unique_ptr<bio::filtering_istreambuf>& s) {
+                                              bio::copy(*s, bio::back_inserter(decompressed));
+                                           } },
+                 strm.buf);
+      return decompressed;
+   };
+
+   for (uint32_t block_num = 1; block_num <= 3; ++block_num)
+      write_block(block_num);
+
+   // any number of streams can be open at once
+   std::optional<eosio::locked_decompress_stream> first = log.create_locked_decompress_stream();
+   std::optional<eosio::locked_decompress_stream> second = log.create_locked_decompress_stream(std::try_to_lock);
+   BOOST_REQUIRE(second->lock.owns_lock());
+   BOOST_REQUIRE_EQUAL(log.get_unpacked_entry(2, *first), data.size() * sizeof(data[0]));
+   BOOST_REQUIRE_EQUAL(log.get_unpacked_entry(3, *second), data.size() * sizeof(data[0]));
+
+   // appending does not wait for readers
+   write_block(4);
+
+   // a fork rewrites block 3, it waits for the open streams and new streams are held off meanwhile
+   std::thread fork([&]() { write_block(3, "fork"); });
+   while (log.create_locked_decompress_stream(std::try_to_lock).lock.owns_lock())
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+   auto decompressed = read_all(*second);
+   BOOST_CHECK(std::equal(decompressed.begin(), decompressed.end(), (const char*)data.data()));
+   BOOST_CHECK(log.get_block_id(3) == block_id_for(3));
+   first.reset();
+   second.reset();
+   fork.join();
+
+   BOOST_CHECK(log.get_block_id(3) == block_id_for(3, "fork"));
+   BOOST_CHECK_EQUAL(log.block_range().second, 4u);
+   BOOST_CHECK(log.create_locked_decompress_stream(std::try_to_lock).lock.owns_lock());
+}
+
 BOOST_FIXTURE_TEST_CASE(test_session_no_prune, state_history_test_fixture) {
    try {
       // setup block head for the server
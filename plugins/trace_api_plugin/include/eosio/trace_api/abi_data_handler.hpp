@@ -55,7 +55,7 @@ namespace eosio {
       };
 
    private:
-      std::map<chain::name, std::shared_ptr<chain::abi_serializer>> abi_serializer_by_account;
+      std::map<chain::name, std::shared_ptr<const chain::abi_serializer>> abi_serializer_by_account;
       exception_handler except_handler;
    };
 } }
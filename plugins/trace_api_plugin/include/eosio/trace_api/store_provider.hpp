@@ -10,6 +10,7 @@
 #include <eosio/trace_api/metadata_log.hpp>
 #include <eosio/trace_api/data_log.hpp>
 #include <eosio/trace_api/compressed_file.hpp>
+#include <eosio/trace_api/trx_id_index.hpp>
 
 namespace eosio::trace_api {
 
@@ -201,6 +202,17 @@ namespace eosio::trace_api {
        */
       bool find_trx_id_slice(uint32_t slice_number, open_state state, fc::cfile& trx_id_file, bool open_file = true) const;
 
+      /**
+       * Find the read-only trx id index file of a finalized trx id slice
+       *
+       * @param slice_number : slice number of the requested slice file
+       * @param trx_id_index_file : the cfile that will be set to the appropriate slice filename (always)
+       *                            and opened read-only (if it was found)
+       * @param open_file : indicate if the file should be opened (if found) or not
+       * @return true if file was found (i.e. already existed)
+       */
+      bool find_trx_id_index_slice(uint32_t slice_number, fc::cfile& trx_id_index_file, bool open_file = true) const;
+
       /**
        * set the LIB for maintenance
        * @param lib
@@ -220,6 +232,7 @@ namespace eosio::trace_api {
       /**
        * Cleans up all slices that are no longer needed to maintain the minimum number of blocks past lib
        * Compresses up all slices that can be compressed
+       * Indexes the trx ids of all slices that are completely irreversible
        *
        * @param lib : block number of the current lib
        */
@@ -246,6 +259,7 @@ namespace eosio::trace_api {
       std::optional<uint32_t> _last_cleaned_up_slice;
       const std::optional<uint32_t> _minimum_uncompressed_irreversible_history_blocks;
       std::optional<uint32_t> _last_compressed_slice;
+      std::optional<uint32_t> _last_trx_id_indexed_slice;
       const size_t _compression_seek_point_stride;
 
       std::mutex _maintenance_mtx;
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <fc/io/cfile.hpp>
+#include <eosio/chain/types.hpp>
+
+namespace eosio::trace_api {
+
+   class malformed_trx_id_index : public std::runtime_error {
+   public:
+      explicit malformed_trx_id_index(const char* what_arg)
+         :std::runtime_error(what_arg)
+      {}
+      explicit malformed_trx_id_index(const std::string& what_arg)
+         :std::runtime_error(what_arg)
+      {}
+   };
+
+   /**
+    * Read-only lookup structure for the transaction ids of a finalized trx id slice.  It is built once by the
+    * maintenance thread after every block of the slice is irreversible and is never modified afterwards.
+    *
+    *  A trx id index file looks like this on the filesystem:
+    * /====================\ file offset 0
+    * |  header            |
+    * |--------------------| file offset 16
+    * |                    |
+    * |  bloom filter      |
+    * |  (bloom_bits / 8)  |
+    * |                    |
+    * |--------------------| file offset 16 + (bloom_bits / 8)
+    * |                    |
+    * |  open addressed    |
+    * |  hash buckets of   |
+    * |  (trx id,          |
+    * |   block num)       |
+    * |                    |
+    * \====================/  file offset END
+    *
+    * The bloom filter is consulted first so a lookup for a transaction that is not in the slice usually costs a
+    * handful of byte reads.  The bloom filter and the first bucket probed use a 64-bit fold of the transaction id,
+    * buckets hold the whole id so a lookup never returns the block of a colliding transaction.  Buckets are linearly
+    * probed, an empty bucket has a block number of 0.  If a transaction appears more than once in the slice (i.e.
+    * forks) the last entry wins, the same as a front-to-back scan of the trx id slice.
+    */
+   class trx_id_index {
+   public:
+      /// version 1 buckets held only the 64-bit key, such files are reported as malformed
+      static constexpr uint32_t current_version = 2;
+
+      struct header {
+         uint32_t version      = current_version;
+         uint32_t bloom_bits   = 0; // power of 2
+         uint32_t bloom_hashes = 0;
+         uint32_t bucket_count = 0; // power of 2
+      };
+
+      static constexpr size_t header_size = 4 * sizeof(uint32_t);
+      static constexpr size_t bucket_size = sizeof(chain::transaction_id_type) + sizeof(uint32_t);
+
+      /**
+       * Create the index for a trx id slice.  The index is written to a temporary file which is renamed to
+       * index_path when complete so readers never observe a partial index.
+       *
+       * @param trx_id_slice_path : path of the trx id slice to index
+       * @param index_path : path of the index file to create
+       * @return the number of distinct transaction ids indexed
+       */
+      static size_t build(const std::filesystem::path& trx_id_slice_path, const std::filesystem::path& index_path);
+
+      /**
+       * Find the block number containing a transaction using positional reads only
+       *
+       * @param index_file : an open trx id index file
+       * @param trx_id : the transaction id to look for
+       * @return the block number, or empty optional if the slice does not contain the transaction
+       * @throws malformed_trx_id_index if the file is not a valid index or is truncated
+       */
+      static std::optional<uint32_t> find(const fc::cfile& index_file, const chain::transaction_id_type& trx_id);
+
+      static uint64_t key_of(const chain::transaction_id_type& trx_id);
+   };
+}
+
+FC_REFLECT(eosio::trace_api::trx_id_index::header, (version)(bloom_bits)(bloom_hashes)(bucket_count))
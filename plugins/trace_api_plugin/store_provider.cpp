@@ -10,6 +10,7 @@ namespace {
       static constexpr const char* _trace_trx_id_prefix = "trace_trx_id_";
       static constexpr const char* _trace_ext = ".log";
       static constexpr const char* _compressed_trace_ext = ".clog";
+      static constexpr const char* _trx_id_index_ext = ".idx";
       static constexpr int _max_filename_size = std::char_traits<char>::length(_trace_index_prefix) + 10 + 1 + 10 + std::char_traits<char>::length(_compressed_trace_ext) + 1; // "trace_index_" + 10-digits + '-' + 10-digits + ".clog" + null-char
 
       std::string make_filename(const char* slice_prefix, const char* slice_ext, uint32_t slice_number, uint32_t slice_width) {
@@ -110,6 +111,27 @@ namespace eosio::trace_api {
       uint32_t trx_block_num = 0; // number of the block that contains the target trx
       uint32_t trx_entries = 0;   // number of entries that contain the target trx
       while (true){
+         // finalized slices have an index, every block in them is irreversible
+         fc::cfile trx_id_index_file;
+         if (_slice_directory.find_trx_id_index_slice(slice_number, trx_id_index_file)) {
+            yield();
+            std::optional<uint32_t> block_num;
+            bool indexed = false;
+            try {
+               block_num = trx_id_index::find(trx_id_index_file, trx_id);
+               indexed = true;
+            } catch (const malformed_trx_id_index&) {
+               // corrupt, truncated or older index, the trx id slice is still there to scan
+            } catch (const std::ios_base::failure&) {
+            }
+            if (indexed) {
+               if (block_num)
+                  return *block_num;
+               slice_number++;
+               continue;
+            }
+         }
+
          const bool found = _slice_directory.find_trx_id_slice(slice_number, open_state::read, trx_id_file);
          if( !found )
             break; // traversed all slices
@@ -287,6 +309,20 @@ namespace eosio::trace_api {
       return true;
    }
 
+   bool slice_directory::find_trx_id_index_slice(uint32_t slice_number, fc::cfile& trx_id_index_file, bool open_file) const {
+      auto filename = make_filename(_trace_trx_id_prefix, _trx_id_index_ext, slice_number, _width);
+      const auto slice_path = _slice_dir / filename;
+      trx_id_index_file.set_file_path(slice_path);
+
+      const bool file_exists = exists(slice_path);
+      if( !file_exists || !open_file ) {
+         return file_exists;
+      }
+
+      trx_id_index_file.open("rb");
+      return true;
+   }
+
    void slice_directory::set_lib(uint32_t lib) {
       {
          std::scoped_lock lock(_maintenance_mtx);
@@ -372,6 +408,11 @@ namespace eosio::trace_api {
                log(std::string("Removing: ") + trace.get_file_path().generic_string());
                std::filesystem::remove(trace.get_file_path());
             }
+            const bool trx_id_index_found = find_trx_id_index_slice(slice_to_clean, trx_id, dont_open_file);
+            if (trx_id_index_found) {
+               log(std::string("Removing: ") + trx_id.get_file_path().generic_string());
+               std::filesystem::remove(trx_id.get_file_path());
+            }
             const bool trx_id_found = find_trx_id_slice(slice_to_clean, open_state::read, trx_id, dont_open_file);
             if (trx_id_found) {
                log(std::string("Removing: ") + trx_id.get_file_path().generic_string());
@@ -411,5 +452,21 @@ namespace eosio::trace_api {
             }
          });
       }
+
+      // Index the trx ids of every slice whose blocks are all irreversible. Slices that were already cleaned up have
+      // no trx id file and are skipped.
+      process_irreversible_slice_range(lib, 0, _last_trx_id_indexed_slice, [this, &log](uint32_t slice_to_index){
+         fc::cfile trx_id;
+         fc::cfile trx_id_index_file;
+         const bool dont_open_file = false;
+         const bool trx_id_found = find_trx_id_slice(slice_to_index, open_state::read, trx_id, dont_open_file);
+         const bool trx_id_index_found = find_trx_id_index_slice(slice_to_index, trx_id_index_file, dont_open_file);
+
+         if (trx_id_found && !trx_id_index_found) {
+            log(std::string("Indexing: ") + trx_id.get_file_path().generic_string());
+            const auto n = trx_id_index::build(trx_id.get_file_path(), trx_id_index_file.get_file_path());
+            log(std::string("Indexed ") + std::to_string(n) + " trx ids into: " + trx_id_index_file.get_file_path().generic_string());
+         }
+      });
    }
 }
@@ -1066,5 +1066,85 @@ BOOST_AUTO_TEST_SUITE(slice_tests)
       BOOST_REQUIRE(!block2);
    }
 
+   BOOST_FIXTURE_TEST_CASE(store_provider_trx_id_index, test_fixture)
+   {
+      fc::temp_directory tempdir;
+      const uint32_t width = 10;
+      store_provider sp(tempdir.path(), width, std::optional<uint32_t>(), std::optional<uint32_t>(), 0);
+      auto make_id = [](uint32_t n) { return fc::sha256::hash(std::to_string(n)); };
+
+      for (uint32_t bn = 1; bn < 35; ++bn) {
+         sp.append_trx_ids(block_trxs_entry{ .ids = { make_id(bn * 2), make_id(bn * 2 + 1) }, .block_num = bn });
+         sp.append_lib(bn);
+      }
+
+      slice_directory sd(tempdir.path(), width, std::optional<uint32_t>(), std::optional<uint32_t>(), 0);
+      fc::cfile index;
+      sd.run_maintenance_tasks(34, {});
+      BOOST_REQUIRE(sd.find_trx_id_index_slice(0, index));
+      BOOST_REQUIRE(sd.find_trx_id_index_slice(1, index));
+      BOOST_REQUIRE(!sd.find_trx_id_index_slice(2, index, false));
+
+      BOOST_REQUIRE(sd.find_trx_id_index_slice(0, index));
+      BOOST_REQUIRE_EQUAL(*trx_id_index::find(index, make_id(2)), 1u);
+      BOOST_REQUIRE_EQUAL(*trx_id_index::find(index, make_id(19)), 9u);
+      BOOST_REQUIRE(!trx_id_index::find(index, make_id(20)));
+      BOOST_REQUIRE(!trx_id_index::find(index, make_id(1000)));
+
+      // indexed and unindexed slices give the same results
+      for (uint32_t bn = 1; bn < 35; ++bn) {
+         auto n = sp.get_trx_block_number(make_id(bn * 2), std::optional<uint32_t>());
+         BOOST_REQUIRE(n);
+         BOOST_REQUIRE_EQUAL(*n, bn);
+         n = sp.get_trx_block_number(make_id(bn * 2 + 1), std::optional<uint32_t>());
+         BOOST_REQUIRE(n);
+         BOOST_REQUIRE_EQUAL(*n, bn);
+      }
+      BOOST_REQUIRE(!sp.get_trx_block_number(make_id(1000), std::optional<uint32_t>()));
+   }
+
+   BOOST_FIXTURE_TEST_CASE(store_provider_trx_id_index_malformed, test_fixture)
+   {
+      fc::temp_directory tempdir;
+      const uint32_t width = 10;
+      store_provider sp(tempdir.path(), width, std::optional<uint32_t>(), std::optional<uint32_t>(), 0);
+      auto make_id = [](uint32_t n) { return fc::sha256::hash(std::to_string(n)); };
+
+      for (uint32_t bn = 1; bn < 25; ++bn) {
+         sp.append_trx_ids(block_trxs_entry{ .ids = { make_id(bn) }, .block_num = bn });
+         sp.append_lib(bn);
+      }
+
+      slice_directory sd(tempdir.path(), width, std::optional<uint32_t>(), std::optional<uint32_t>(), 0);
+      sd.run_maintenance_tasks(24, {});
+      fc::cfile index;
+      BOOST_REQUIRE(sd.find_trx_id_index_slice(0, index, false));
+      const auto index0 = index.get_file_path();
+      BOOST_REQUIRE(sd.find_trx_id_index_slice(1, index, false));
+      const auto index1 = index.get_file_path();
+
+      // truncated index of slice 0, index of slice 1 with a bad header
+      std::filesystem::resize_file(index0, std::filesystem::file_size(index0) - 1);
+      {
+         fc::cfile f;
+         f.set_file_path(index1);
+         f.open(fc::cfile::update_rw_mode);
+         const uint32_t bad_version = 0xffffffff;
+         f.write(reinterpret_cast<const char*>(&bad_version), sizeof(bad_version));
+         f.flush();
+      }
+
+      BOOST_REQUIRE(sd.find_trx_id_index_slice(0, index));
+      BOOST_REQUIRE_THROW(trx_id_index::find(index, make_id(3)), malformed_trx_id_index);
+
+      // lookups fall back to scanning the trx id slices
+      for (uint32_t bn = 1; bn < 25; ++bn) {
+         auto n = sp.get_trx_block_number(make_id(bn), std::optional<uint32_t>());
+         BOOST_REQUIRE(n);
+         BOOST_REQUIRE_EQUAL(*n, bn);
+      }
+      BOOST_REQUIRE(!sp.get_trx_block_number(make_id(1000), std::optional<uint32_t>()));
+   }
+
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+#include <eosio/trace_api/trx_id_index.hpp>
+#include <eosio/trace_api/metadata_log.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <unordered_map>
+
+namespace {
+   constexpr uint32_t bloom_bits_per_entry = 16;
+   constexpr uint32_t bloom_hashes = 7;
+   constexpr uint32_t min_bloom_bits = 64;
+
+   uint64_t mix64(uint64_t x) {
+      // splitmix64 finalizer
+      x ^= x >> 30;
+      x *= 0xbf58476d1ce4e5b9ULL;
+      x ^= x >> 27;
+      x *= 0x94d049bb133111ebULL;
+      x ^= x >> 31;
+      return x;
+   }
+
+   uint32_t round_up_pow2(uint64_t n) {
+      uint64_t r = 1;
+      while (r < n)
+         r <<= 1;
+      if (r > std::numeric_limits<uint32_t>::max())
+         throw std::runtime_error("trx id index too large");
+      return static_cast<uint32_t>(r);
+   }
+
+   uint64_t bloom_bit(uint64_t key, uint32_t i, uint32_t bloom_bits) {
+      const uint64_t h2 = mix64(key) | 1;
+      return (key + i * h2) & (bloom_bits - 1);
+   }
+}
+
+namespace eosio::trace_api {
+
+   static_assert(trx_id_index::header_size == sizeof(trx_id_index::header), "unexpected size for trx id index header");
+
+   uint64_t trx_id_index::key_of(const chain::transaction_id_type& trx_id) {
+      uint64_t key = 0;
+      for (const auto word : trx_id._hash)
+         key = mix64(key ^ word);
+      return key;
+   }
+
+   size_t trx_id_index::build(const std::filesystem::path& trx_id_slice_path, const std::filesystem::path& index_path) {
+      std::unordered_map<chain::transaction_id_type, uint32_t> entries;
+      {
+         fc::cfile trx_id_file;
+         trx_id_file.set_file_path(trx_id_slice_path);
+         trx_id_file.open("rb");
+         auto ds = trx_id_file.create_datastream();
+         const uint64_t end = file_size(trx_id_slice_path);
+         metadata_log_entry entry;
+         while (trx_id_file.tellp() < end) {
+            fc::raw::unpack(ds, entry);
+            if (std::holds_alternative<block_trxs_entry>(entry)) {
+               const auto& trxs_entry = std::get<block_trxs_entry>(entry);
+               for (const auto& id : trxs_entry.ids)
+                  entries[id] = trxs_entry.block_num;
+            }
+         }
+      }
+
+      header h;
+      h.bloom_bits   = round_up_pow2(std::max<uint64_t>(min_bloom_bits, uint64_t(entries.size()) * bloom_bits_per_entry));
+      h.bloom_hashes = bloom_hashes;
+      h.bucket_count = round_up_pow2(std::max<uint64_t>(1, uint64_t(entries.size()) * 2)); // load factor <= 0.5
+
+      std::vector<char> bloom(h.bloom_bits / 8);
+      std::vector<std::pair<chain::transaction_id_type, uint32_t>> buckets(h.bucket_count);
+      for (const auto& [id, block_num] : entries) {
+         const uint64_t key = key_of(id);
+         for (uint32_t i = 0; i < h.bloom_hashes; ++i) {
+            const auto bit = bloom_bit(key, i, h.bloom_bits);
+            bloom[bit / 8] |= char(1 << (bit % 8));
+         }
+         uint64_t b = key & (h.bucket_count - 1);
+         while (buckets[b].second != 0)
+            b = (b + 1) & (h.bucket_count - 1);
+         buckets[b] = {id, block_num};
+      }
+
+      auto tmp_path = index_path;
+      tmp_path += ".tmp";
+      {
+         fc::cfile index_file;
+         index_file.set_file_path(tmp_path);
+         index_file.open(fc::cfile::truncate_rw_mode);
+         auto data = fc::raw::pack(h);
+         index_file.write(data.data(), data.size());
+         index_file.write(bloom.data(), bloom.size());
+         for (const auto& [id, block_num] : buckets) {
+            index_file.write(id.data(), id.data_size());
+            index_file.write(reinterpret_cast<const char*>(&block_num), sizeof(block_num));
+         }
+         index_file.flush();
+      }
+      std::filesystem::rename(tmp_path, index_path);
+      return entries.size();
+   }
+
+   std::optional<uint32_t> trx_id_index::find(const fc::cfile& index_file, const chain::transaction_id_type& trx_id) {
+      char hbuf[header_size];
+      index_file.read_at(hbuf, sizeof(hbuf), 0);
+      header h;
+      fc::datastream<const char*> ds(hbuf, sizeof(hbuf));
+      fc::raw::unpack(ds, h);
+      if (h.version != current_version || h.bucket_count == 0 || (h.bucket_count & (h.bucket_count - 1)) != 0 ||
+          h.bloom_bits < 8 || (h.bloom_bits & (h.bloom_bits - 1)) != 0 ||
+          index_file.filesize() != header_size + h.bloom_bits / 8 + uint64_t(h.bucket_count) * bucket_size) {
+         throw malformed_trx_id_index("Invalid trx id index file: " + index_file.get_file_path().generic_string());
+      }
+
+      const uint64_t key = key_of(trx_id);
+      for (uint32_t i = 0; i < h.bloom_hashes; ++i) {
+         const auto bit = bloom_bit(key, i, h.bloom_bits);
+         char byte;
+         index_file.read_at(&byte, 1, header_size + bit / 8);
+         if ((byte & char(1 << (bit % 8))) == 0)
+            return {};
+      }
+
+      const uint64_t buckets_pos = header_size + h.bloom_bits / 8;
+      uint64_t b = key & (h.bucket_count - 1);
+      for (uint32_t probes = 0; probes < h.bucket_count; ++probes) {
+         char bbuf[bucket_size];
+         index_file.read_at(bbuf, sizeof(bbuf), buckets_pos + b * bucket_size);
+         uint32_t block_num;
+         memcpy(&block_num, bbuf + sizeof(chain::transaction_id_type), sizeof(block_num));
+         if (block_num == 0)
+            return {};
+         if (memcmp(bbuf, trx_id.data(), sizeof(chain::transaction_id_type)) == 0)
+            return block_num;
+         b = (b + 1) & (h.bucket_count - 1);
+      }
+      return {};
+   }
+}
@@ -37,6 +37,8 @@ class PerformanceTest:
         minTpsToTest: int=1
         testIterationMinStep: int=500
         tpsLimitPerGenerator: int=4000
+        trxGenSignThreads: int=0
+        trxGenSpinWaitUs: int=0
         delReport: bool=False
         delTestReport: bool=False
         numAddlBlocksToPrune: int=2
@@ -113,6 +115,7 @@ class PerformanceTest:
             print(f"Running scenario: floor {floor} binSearchTarget {binSearchTarget} ceiling {ceiling}")
             scenarioResult = PerformanceTest.PerfTestSearchIndivResult(success=False, searchTarget=binSearchTarget, searchFloor=floor, searchCeiling=ceiling)
             ptbConfig = PerformanceTestBasic.PtbConfig(targetTps=binSearchTarget, testTrxGenDurationSec=self.ptConfig.testDurationSec, tpsLimitPerGenerator=self.ptConfig.tpsLimitPerGenerator,
+                                                       trxGenSignThreads=self.ptConfig.trxGenSignThreads, trxGenSpinWaitUs=self.ptConfig.trxGenSpinWaitUs,
                                                        numAddlBlocksToPrune=self.ptConfig.numAddlBlocksToPrune, logDirRoot=logDirRoot, delReport=delReport,
                                                        quiet=quiet, delPerfLogs=delPerfLogs, userTrxDataFile=self.ptConfig.userTrxDataFile, endpointMode=self.ptConfig.endpointMode,
                                                        trxGenerator=self.ptConfig.trxGenerator, saveState=saveState)
@@ -156,6 +159,7 @@ class PerformanceTest:
             print(f"Running scenario: floor {absFloor} searchTarget {searchTarget} ceiling {absCeiling}")
             scenarioResult = PerformanceTest.PerfTestSearchIndivResult(success=False, searchTarget=searchTarget, searchFloor=absFloor, searchCeiling=absCeiling)
             ptbConfig = PerformanceTestBasic.PtbConfig(targetTps=searchTarget, testTrxGenDurationSec=self.ptConfig.testDurationSec, tpsLimitPerGenerator=self.ptConfig.tpsLimitPerGenerator,
+                                                    trxGenSignThreads=self.ptConfig.trxGenSignThreads, trxGenSpinWaitUs=self.ptConfig.trxGenSpinWaitUs,
                                                     numAddlBlocksToPrune=self.ptConfig.numAddlBlocksToPrune, logDirRoot=self.loggingConfig.ptbLogsDirPath, delReport=self.ptConfig.delReport,
                                                     quiet=self.ptConfig.quiet, delPerfLogs=self.ptConfig.delPerfLogs, userTrxDataFile=self.ptConfig.userTrxDataFile, endpointMode=self.ptConfig.endpointMode,
                                                     trxGenerator=self.ptConfig.trxGenerator, saveState=self.ptConfig.saveState)
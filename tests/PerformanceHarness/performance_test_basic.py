@@ -165,6 +165,8 @@ class PerformanceTestBasic:
         targetTps: int=8000
         testTrxGenDurationSec: int=30
         tpsLimitPerGenerator: int=4000
+        trxGenSignThreads: int=0
+        trxGenSpinWaitUs: int=0
         numAddlBlocksToPrune: int=2
         logDirRoot: Path=Path(".")
         delReport: bool=False
@@ -479,7 +481,8 @@ class PerformanceTestBasic:
                                                        accts=','.join(map(str, self.accountNames)), privateKeys=','.join(map(str, self.accountPrivKeys)),
                                                        trxGenDurationSec=self.ptbConfig.testTrxGenDurationSec, logDir=self.trxGenLogDirPath,
                                                        abiFile=abiFile, actionsData=actionsDataJson, actionsAuths=actionsAuthsJson,
-                                                       tpsTrxGensConfig=tpsTrxGensConfig, endpointMode=self.ptbConfig.endpointMode, apiEndpoint=self.ptbConfig.apiEndpoint)
+                                                       tpsTrxGensConfig=tpsTrxGensConfig, endpointMode=self.ptbConfig.endpointMode, apiEndpoint=self.ptbConfig.apiEndpoint,
+                                                       signThreads=self.ptbConfig.trxGenSignThreads, spinWaitUs=self.ptbConfig.trxGenSpinWaitUs)
 
         trxGenExitCodes = self.cluster.trxGenLauncher.launch()
         print(f"Transaction Generator exit codes: {trxGenExitCodes}")
@@ -704,6 +707,8 @@ class PtbArgumentsHandler(object):
         ptbBaseParserGroup.add_argument("--api-nodes", type=int, help=argparse.SUPPRESS if suppressHelp else "API nodes count", default=defApiNodeCnt)
         ptbBaseParserGroup.add_argument("--api-nodes-read-only-threads", type=int, help=argparse.SUPPRESS if suppressHelp else "API nodes read only threads count for use with read-only transactions", default=0)
         ptbBaseParserGroup.add_argument("--tps-limit-per-generator", type=int, help=argparse.SUPPRESS if suppressHelp else "Maximum amount of transactions per second a single generator can have.", default=4000)
+        ptbBaseParserGroup.add_argument("--trx-gen-sign-threads", type=int, help=argparse.SUPPRESS if suppressHelp else "Number of threads each transaction generator uses to sign transactions ahead of sending. 0 signs on the sending thread.", default=0)
+        ptbBaseParserGroup.add_argument("--trx-gen-spin-wait-us", type=int, help=argparse.SUPPRESS if suppressHelp else "Microseconds before each scheduled send each transaction generator spends spinning instead of sleeping. 0 disables spinning.", default=0)
         ptbBaseParserGroup.add_argument("--genesis", type=str, help=argparse.SUPPRESS if suppressHelp else "Path to genesis.json", default="tests/PerformanceHarness/genesis.json")
         ptbBaseParserGroup.add_argument("--num-blocks-to-prune", type=int, help=argparse.SUPPRESS if suppressHelp else ("The number of potentially non-empty blocks, in addition to leading and trailing size 0 blocks, "
                                                                 "to prune from the beginning and end of the range of blocks of interest for evaluation."), default=2)
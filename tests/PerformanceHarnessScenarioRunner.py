@@ -57,6 +57,8 @@ def main():
         ptbConfig = performance_test_basic.PerformanceTestBasic.PtbConfig(targetTps=args.target_tps,
                                                 testTrxGenDurationSec=args.test_duration_sec,
                                                 tpsLimitPerGenerator=args.tps_limit_per_generator,
+                                                trxGenSignThreads=args.trx_gen_sign_threads,
+                                                trxGenSpinWaitUs=args.trx_gen_spin_wait_us,
                                                 numAddlBlocksToPrune=args.num_blocks_to_prune,
                                                 logDirRoot=".",
                                                 delReport=args.del_report, quiet=args.quiet,
@@ -76,6 +78,8 @@ def main():
                                             minTpsToTest=args.min_tps_to_test,
                                             testIterationMinStep=args.test_iteration_min_step,
                                             tpsLimitPerGenerator=args.tps_limit_per_generator,
+                                            trxGenSignThreads=args.trx_gen_sign_threads,
+                                            trxGenSpinWaitUs=args.trx_gen_spin_wait_us,
                                             delReport=args.del_report,
                                             delTestReport=args.del_test_report,
                                             numAddlBlocksToPrune=args.num_blocks_to_prune,
@@ -38,7 +38,7 @@ class TpsTrxGensConfig:
 class TransactionGeneratorsLauncher:
 
     def __init__(self, trxGenerator: Path, chainId: int, lastIrreversibleBlockId: int, contractOwnerAccount: str, accts: str, privateKeys: str, trxGenDurationSec: int, logDir: str,
-                 abiFile: Path, actionsData, actionsAuths, tpsTrxGensConfig: TpsTrxGensConfig, endpointMode: str, apiEndpoint: str=None):
+                 abiFile: Path, actionsData, actionsAuths, tpsTrxGensConfig: TpsTrxGensConfig, endpointMode: str, apiEndpoint: str=None, signThreads: int=0, spinWaitUs: int=0):
         self.trxGenerator = trxGenerator
         self.chainId = chainId
         self.lastIrreversibleBlockId = lastIrreversibleBlockId
@@ -53,6 +53,8 @@ class TransactionGeneratorsLauncher:
         self.actionsAuths = actionsAuths
         self.endpointMode = endpointMode
         self.apiEndpoint = apiEndpoint
+        self.signThreads = signThreads
+        self.spinWaitUs = spinWaitUs
 
     def launch(self, waitToComplete=True):
         self.subprocess_ret_codes = []
@@ -80,6 +82,10 @@ class TransactionGeneratorsLauncher:
                                         '--actions-auths', f'{self.actionsAuths}'])
             if self.apiEndpoint is not None:
                 popenStringList.extend(['--api-endpoint', f'{self.apiEndpoint}'])
+            if self.signThreads > 0:
+                popenStringList.extend(['--sign-threads', f'{self.signThreads}'])
+            if self.spinWaitUs > 0:
+                popenStringList.extend(['--spin-wait-us', f'{self.spinWaitUs}'])
 
             if Utils.Debug:
                 Print(f"Running transaction generator {self.trxGenerator} : {' '.join(popenStringList)}")
@@ -643,4 +643,23 @@ BOOST_DATA_TEST_CASE(empty_prune_to_partitioned_transitions, bdata::xrange(1, 11
 
 }  FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE(read_block_header_prefix) { try {
+   block_log_fixture t(true, false, false, std::optional<uint32_t>());
+   t.startup(1);
+
+   // a small header of a large block is read from a prefix of the block, a large header from the whole block
+   for (uint32_t i = 2; i <= 3; ++i) {
+      eosio::chain::signed_block_ptr p = std::make_shared<eosio::chain::signed_block>();
+      p->previous._hash[0] = fc::endian_reverse_u32(i-1);
+      p->header_extensions.emplace_back(0, std::vector<char>(i == 2 ? 16 : payload_size(), 'A'));
+      p->block_extensions.emplace_back(0, std::vector<char>(payload_size(), 'B'));
+      t.log->append(p, p->calculate_id(), fc::raw::pack(*p));
+
+      auto bh = t.log->read_block_header_by_num(i);
+      BOOST_REQUIRE(bh);
+      BOOST_REQUIRE(bh->calculate_id() == p->calculate_id());
+      BOOST_REQUIRE(t.log->read_block_id_by_num(i) == p->calculate_id());
+   }
+}  FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
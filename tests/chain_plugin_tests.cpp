@@ -130,6 +130,50 @@ BOOST_FIXTURE_TEST_CASE( get_block_with_invalid_abi, validating_tester ) try {
 
 } FC_LOG_AND_RETHROW() /// get_block_with_invalid_abi
 
+BOOST_FIXTURE_TEST_CASE( shared_abi_serializer_cache, validating_tester ) try {
+   produce_blocks(2);
+
+   create_accounts( {"asserter"_n} );
+   set_code( "asserter"_n, test_contracts::asserter_wasm() );
+   set_abi( "asserter"_n, test_contracts::asserter_abi() );
+   produce_blocks(1);
+
+   auto resolver = make_resolver( *control, fc::microseconds::maximum(), throw_on_yield::yes );
+
+   // same abi_sequence, same serializer instance
+   auto first = resolver( "asserter"_n );
+   BOOST_REQUIRE( first );
+   BOOST_TEST( first == resolver( "asserter"_n ) );
+   BOOST_TEST( first->get_struct( "procassert" ).fields.at(1).name == "message" );
+   BOOST_TEST( !resolver( "nonexistent"_n ) );
+
+   // setabi invalidates the entry
+   std::string abi2 = test_contracts::asserter_abi();
+   auto pos = abi2.find( "\"message\"" );
+   BOOST_REQUIRE( pos != std::string::npos );
+   abi2.replace( pos, 9, "\"msg\"" ); // rename a field
+   set_abi( "asserter"_n, abi2.c_str() );
+   produce_blocks(1);
+
+   auto second = resolver( "asserter"_n );
+   BOOST_REQUIRE( second );
+   BOOST_TEST( second != first );
+   BOOST_TEST( second == resolver( "asserter"_n ) );
+   BOOST_TEST( second->get_struct( "procassert" ).fields.at(1).name == "msg" );
+   // the old instance is still usable by whoever holds it
+   BOOST_TEST( first->get_struct( "procassert" ).fields.at(1).name == "message" );
+
+   // invalid abi is not cached and keeps throwing
+   auto pos2 = abi2.find( "int8" );
+   BOOST_REQUIRE( pos2 != std::string::npos );
+   abi2.replace( pos2, 4, "xxxx" );
+   set_abi( "asserter"_n, abi2.c_str() );
+   produce_blocks(1);
+   BOOST_CHECK_THROW( resolver( "asserter"_n ), invalid_type_inside_abi );
+   BOOST_CHECK_THROW( resolver( "asserter"_n ), invalid_type_inside_abi );
+
+} FC_LOG_AND_RETHROW() /// shared_abi_serializer_cache
+
 BOOST_AUTO_TEST_CASE( get_consensus_parameters ) try {
    tester t{setup_policy::old_wasm_parser};
    t.produce_blocks(1);
@@ -29,7 +29,12 @@ static auto get_table_rows_full = [](chain_apis::read_only& plugin,
                                      const fc::time_point& deadline) -> chain_apis::read_only::get_table_rows_result {   
    auto res_nm_v =  plugin.get_table_rows(params, deadline)();
    BOOST_REQUIRE(!std::holds_alternative<fc::exception_ptr>(res_nm_v));
-   return std::get<chain_apis::read_only::get_table_rows_result>(std::move(res_nm_v));
+   auto res = std::get<chain_apis::read_only::get_table_rows_result>(std::move(res_nm_v));
+   // the streamed response of the http endpoint matches the result serialized as a whole
+   auto json_v = plugin.get_table_rows_json(params, deadline)();
+   BOOST_REQUIRE(!std::holds_alternative<fc::exception_ptr>(json_v));
+   BOOST_CHECK_EQUAL(std::get<fc::raw_json>(json_v).json, fc::to_json_string(res));
+   return res;
 };
    
 
@@ -98,4 +103,41 @@ BOOST_FIXTURE_TEST_CASE( get_table_next_key_test, validating_tester ) try {
 
 } FC_LOG_AND_RETHROW() /// get_table_next_key_test
 
+BOOST_FIXTURE_TEST_CASE( get_table_seckey_no_abi_test, validating_tester ) try {
+   create_account("test"_n);
+
+   set_code( "test"_n, test_contracts::get_table_seckey_test_wasm() );
+   set_abi( "test"_n, test_contracts::get_table_seckey_test_abi() );
+   produce_block();
+
+   push_action("test"_n, "addnumobj"_n, "test"_n, mutable_variant_object()("input", 2)("nm", "a"));
+   push_action("test"_n, "addnumobj"_n, "test"_n, mutable_variant_object()("input", 5)("nm", "b"));
+   produce_block();
+
+   chain_apis::read_only plugin(*(this->control), {}, fc::microseconds::maximum(), fc::microseconds::maximum(), {});
+   chain_apis::read_only::get_table_rows_params params{};
+   params.json = true;
+   params.code = "test"_n;
+   params.scope = "test";
+   params.table = "numobjs"_n;
+   params.key_type = "name";
+   params.index_position = "6";
+   params.limit = 10;
+
+   // serializer is built and cached on first use, then found in the cache
+   BOOST_REQUIRE_EQUAL(get_table_rows_full(plugin, params, fc::time_point::maximum()).rows.size(), 2u);
+   BOOST_REQUIRE_EQUAL(get_table_rows_full(plugin, params, fc::time_point::maximum()).rows.size(), 2u);
+
+   // remove the abi, rows of the secondary index are still found but can not be decoded
+   push_action(config::system_account_name, "setabi"_n, "test"_n, mutable_variant_object()("account", "test")("abi", bytes()));
+   produce_block();
+
+   BOOST_CHECK_THROW(plugin.get_table_rows(params, fc::time_point::maximum())(), contract_table_query_exception);
+   BOOST_CHECK_THROW(plugin.get_table_rows_json(params, fc::time_point::maximum())(), contract_table_query_exception);
+
+   params.json = false;
+   BOOST_REQUIRE_EQUAL(get_table_rows_full(plugin, params, fc::time_point::maximum()).rows.size(), 2u);
+
+} FC_LOG_AND_RETHROW() /// get_table_seckey_no_abi_test
+
 BOOST_AUTO_TEST_SUITE_END()
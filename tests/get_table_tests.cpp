@@ -30,7 +30,12 @@ static auto get_table_rows_full = [](chain_apis::read_only& plugin,
                                      const fc::time_point& deadline) -> chain_apis::read_only::get_table_rows_result {   
    auto res_nm_v =  plugin.get_table_rows(params, deadline)();
    BOOST_REQUIRE(!std::holds_alternative<fc::exception_ptr>(res_nm_v));
-   return std::get<chain_apis::read_only::get_table_rows_result>(std::move(res_nm_v));
+   auto res = std::get<chain_apis::read_only::get_table_rows_result>(std::move(res_nm_v));
+   // the streamed response of the http endpoint matches the result serialized as a whole
+   auto json_v = plugin.get_table_rows_json(params, deadline)();
+   BOOST_REQUIRE(!std::holds_alternative<fc::exception_ptr>(json_v));
+   BOOST_CHECK_EQUAL(std::get<fc::raw_json>(json_v).json, fc::to_json_string(res));
+   return res;
 };
 
 BOOST_AUTO_TEST_SUITE(get_table_tests)
@@ -313,6 +318,63 @@ BOOST_FIXTURE_TEST_CASE( get_table_test, validating_tester ) try {
       BOOST_REQUIRE_EQUAL("7777.0000 CCC", result.rows[0]["balance"].as_string());
    }
 
+   // batch: all rows of several scopes, a scope without the table is an empty result
+   auto get_batch = [&](const chain_apis::read_only::get_table_rows_batch_params& bp, const fc::time_point& deadline) {
+      auto res = plugin.get_table_rows_batch(bp, deadline)();
+      BOOST_REQUIRE(!std::holds_alternative<fc::exception_ptr>(res));
+      return fc::json::from_string(std::get<fc::raw_json>(res).json).get_object();
+   };
+   chain_apis::read_only::get_table_rows_batch_params bp;
+   bp.code = "eosio.token"_n;
+   bp.table = "accounts"_n;
+   bp.json = true;
+   bp.scopes = {"inita", "initb", "initc"};
+   auto batch = get_batch(bp, fc::time_point::maximum());
+   BOOST_REQUIRE_EQUAL(false, batch["more"].as_bool());
+   const auto& results = batch["results"].get_array();
+   BOOST_REQUIRE_EQUAL(3u, results.size());
+   BOOST_REQUIRE_EQUAL("inita", results[0]["scope"].as_string());
+   BOOST_REQUIRE_EQUAL(4u, results[0]["rows"].size());
+   BOOST_REQUIRE_EQUAL("9999.0000 AAA", results[0]["rows"][size_t(0)]["balance"].as_string());
+   BOOST_REQUIRE_EQUAL("initb", results[1]["scope"].as_string());
+   BOOST_REQUIRE_EQUAL(4u, results[1]["rows"].size());
+   BOOST_REQUIRE_EQUAL("initc", results[2]["scope"].as_string());
+   BOOST_REQUIRE_EQUAL(0u, results[2]["rows"].size());
+
+   // batch: same rows as get_table_rows of each scope
+   p.lower_bound.clear();
+   p.upper_bound.clear();
+   p.limit = 2;
+   p.reverse = false;
+   p.scope = "initb";
+   bp.limit = 2;
+   batch = get_batch(bp, fc::time_point::maximum());
+   result = get_table_rows_full(plugin, p, fc::time_point::maximum());
+   BOOST_REQUIRE_EQUAL(fc::json::to_string(batch["results"][size_t(1)]["rows"], fc::time_point::maximum()),
+                       fc::json::to_string(fc::variant(result.rows), fc::time_point::maximum()));
+   BOOST_REQUIRE_EQUAL(true, batch["results"][size_t(1)]["more"].as_bool());
+   BOOST_REQUIRE_EQUAL(result.next_key, batch["results"][size_t(1)]["next_key"].as_string());
+
+   // batch: primary key lookups, with ram payer, missing keys are skipped
+   bp.keys = {"SYS", "ZZZ", "BBB"};
+   bp.show_payer = true;
+   batch = get_batch(bp, fc::time_point::maximum());
+   const auto& key_results = batch["results"].get_array();
+   BOOST_REQUIRE_EQUAL(3u, key_results.size());
+   BOOST_REQUIRE_EQUAL(2u, key_results[0]["rows"].size());
+   BOOST_REQUIRE_EQUAL("10000.0000 SYS", key_results[0]["rows"][size_t(0)]["data"]["balance"].as_string());
+   BOOST_REQUIRE_EQUAL("8888.0000 BBB", key_results[0]["rows"][size_t(1)]["data"]["balance"].as_string());
+   BOOST_REQUIRE_EQUAL("eosio", key_results[0]["rows"][size_t(1)]["payer"].as_string());
+   BOOST_REQUIRE_EQUAL(0u, key_results[2]["rows"].size());
+
+   // batch: stops at the row limit of a limited request and reports more
+   bp.keys.clear();
+   bp.limit = 1000;
+   bp.scopes.assign(chain_apis::read_only::max_return_items, "inita");
+   batch = get_batch(bp, fc::time_point::now() + fc::seconds(60));
+   BOOST_REQUIRE_EQUAL(true, batch["more"].as_bool());
+   BOOST_REQUIRE_EQUAL(chain_apis::read_only::max_return_items / 4, batch["results"].size());
+
 } FC_LOG_AND_RETHROW()
 
 BOOST_FIXTURE_TEST_CASE( get_table_by_seckey_test, validating_tester ) try {
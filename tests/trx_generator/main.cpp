@@ -57,6 +57,9 @@ int main(int argc, char** argv) {
          ("monitor-spinup-time-us", bpo::value<int64_t>(&spinup_time_us)->default_value(1000000), "Number of microseconds to wait before monitoring TPS. Defaults to 1000000 (1s).")
          ("monitor-max-lag-percent", bpo::value<uint32_t>(&max_lag_per)->default_value(5), "Max percentage off from expected transactions sent before being in violation. Defaults to 5.")
          ("monitor-max-lag-duration-us", bpo::value<int64_t>(&max_lag_duration_us)->default_value(1000000), "Max microseconds that transaction generation can be in violation before quitting. Defaults to 1000000 (1s).")
+         ("sign-threads", bpo::value<uint16_t>(&trx_gen_base_config._sign_threads)->default_value(0), "Number of threads used to sign transactions ahead of sending. 0 signs each transaction on the sending thread. Defaults to 0.")
+         ("sign-batch-size", bpo::value<uint32_t>(&trx_gen_base_config._sign_batch_size)->default_value(1000), "Number of transactions signed ahead per batch when sign-threads is non-zero. Defaults to 1000.")
+         ("spin-wait-us", bpo::value<int64_t>(&tester_config._spin_wait_us)->default_value(0), "Microseconds before each scheduled send spent spinning instead of sleeping for a more precise send rate. Defaults to 0.")
          ("log-dir", bpo::value<std::string>(&trx_gen_base_config._log_dir), "set the logs directory")
          ("stop-on-trx-failed", bpo::value<bool>(&trx_gen_base_config._stop_on_trx_failed)->default_value(true), "stop transaction generation if sending fails.")
          ("abi-file", bpo::value<std::string>(&user_trx_config._abi_data_file_path), "The path to the contract abi file to use for the supplied transaction action data")
@@ -169,6 +172,18 @@ int main(int argc, char** argv) {
          return INITIALIZE_FAIL;
       }
 
+      if(tester_config._spin_wait_us < 0) {
+         ilog("Initialization error: spin-wait-us cannot be negative");
+         cli.print(std::cerr);
+         return INITIALIZE_FAIL;
+      }
+
+      if(trx_gen_base_config._sign_threads > 0 && trx_gen_base_config._sign_batch_size < 1) {
+         ilog("Initialization error: sign-batch-size must be 1+ when sign-threads is used");
+         cli.print(std::cerr);
+         return INITIALIZE_FAIL;
+      }
+
       if(max_lag_per > 100) {
          ilog("Initialization error: max-lag-percent must be between 0 and 100");
          cli.print(std::cerr);
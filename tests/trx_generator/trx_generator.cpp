@@ -47,16 +47,89 @@ namespace eosio::testing {
       }
    }
 
-   void trx_generator_base::update_resign_transaction(chain::signed_transaction& trx, const fc::crypto::private_key& priv_key, uint64_t& nonce_prefix, uint64_t& nonce,
-                                                      const fc::microseconds& trx_expiration, const chain::chain_id_type& chain_id, const chain::block_id_type& last_irr_block_id) {
+   void trx_generator_base::update_transaction(chain::signed_transaction& trx, uint64_t& nonce_prefix, uint64_t& nonce,
+                                               const fc::microseconds& trx_expiration, const chain::block_id_type& last_irr_block_id) {
       trx.context_free_actions.clear();
       trx.context_free_actions.emplace_back(std::vector<chain::permission_level>(), chain::config::null_account_name, chain::name("nonce"),
          fc::raw::pack(std::to_string(_config._generator_id) + ":" + std::to_string(nonce_prefix) + ":" + std::to_string(++nonce) + ":" + std::to_string(fc::time_point::now().time_since_epoch().count())));
       set_transaction_headers(trx, last_irr_block_id, trx_expiration);
       trx.signatures.clear();
+   }
+
+   void trx_generator_base::update_resign_transaction(chain::signed_transaction& trx, const fc::crypto::private_key& priv_key, uint64_t& nonce_prefix, uint64_t& nonce,
+                                                      const fc::microseconds& trx_expiration, const chain::chain_id_type& chain_id, const chain::block_id_type& last_irr_block_id) {
+      update_transaction(trx, nonce_prefix, nonce, trx_expiration, last_irr_block_id);
       trx.sign(priv_key, chain_id);
    }
 
+   void trx_generator_base::start_presigning() {
+      if (!presign_enabled() || _trxs.empty())
+         return;
+      ilog("Starting ${n} transaction signing threads, batch size ${b}", ("n", _config._sign_threads)("b", _config._sign_batch_size));
+      _sign_thread_pool.start(_config._sign_threads, [](const fc::exception& e) {
+         elog("Exception in transaction signing thread: ${e}", ("e", e.to_detail_string()));
+      });
+      while (_presigned.size() < presign_queue_depth) {
+         queue_presigned_batch();
+      }
+   }
+
+   void trx_generator_base::stop_presigning() {
+      if (!presign_enabled())
+         return;
+      for (auto& batch : _presigned) {
+         try {
+            batch.wait();
+         } catch (...) {}
+      }
+      _presigned.clear();
+      _sign_thread_pool.stop();
+   }
+
+   // Updates the next _sign_batch_size transactions on this thread, since generating actions and nonces is stateful,
+   // and leaves the expensive signing and packing to the signing thread pool split into one slice per thread.
+   void trx_generator_base::queue_presigned_batch() {
+      const size_t batch_size = std::max<size_t>(_config._sign_batch_size, 1);
+      presigned_trx_batch& batch = _presigned.emplace_back();
+      batch._trxs.reserve(batch_size);
+      batch._signers.reserve(batch_size);
+      for (size_t i = 0; i < batch_size; ++i, ++_presign_count) {
+         signed_transaction_w_signer& tmpl = _trxs.at(_presign_count % _trxs.size());
+         update_transaction(tmpl._trx, ++_nonce_prefix, _nonce, _config._trx_expiration_us, _config._last_irr_block_id);
+         batch._trxs.push_back(tmpl._trx);
+         batch._signers.push_back(&tmpl._signer);
+      }
+      batch._packed.resize(batch_size);
+
+      const size_t slices = std::min<size_t>(_config._sign_threads, batch_size);
+      const size_t per_slice = (batch_size + slices - 1) / slices;
+      batch._signed.reserve(slices);
+      for (size_t begin = 0; begin < batch_size; begin += per_slice) {
+         const size_t end = std::min(begin + per_slice, batch_size);
+         batch._signed.push_back(chain::post_async_task(_sign_thread_pool.get_executor(), [&batch, begin, end, &chain_id = _config._chain_id]() {
+            for (size_t i = begin; i < end; ++i) {
+               batch._trxs[i].sign(*batch._signers[i], chain_id);
+               batch._packed[i] = chain::packed_transaction(std::move(batch._trxs[i]));
+            }
+         }));
+      }
+   }
+
+   presigned_trx_batch& trx_generator_base::next_presigned_batch() {
+      if (_presigned.front().exhausted()) {
+         _presigned.pop_front();
+         queue_presigned_batch();
+      }
+      presigned_trx_batch& batch = _presigned.front();
+      batch.wait();
+      return batch;
+   }
+
+   const chain::packed_transaction& trx_generator_base::next_presigned_trx() {
+      presigned_trx_batch& batch = next_presigned_batch();
+      return batch._packed[batch._next++];
+   }
+
    chain::bytes transfer_trx_generator::make_transfer_data(const chain::name& from, const chain::name& to, const chain::asset& quantity, const std::string& memo) {
       return fc::raw::pack< chain::name>(from, to, quantity, memo);
    }
@@ -114,6 +187,7 @@ namespace eosio::testing {
       ilog("Update each trx to qualify as unique and fresh timestamps, re-sign trx, and send each updated transactions via p2p transaction provider");
 
       _provider.setup();
+      start_presigning();
       return true;
    }
 
@@ -178,11 +252,11 @@ namespace eosio::testing {
       }
    }
 
-   void trx_generator::update_resign_transaction(chain::signed_transaction& trx, const fc::crypto::private_key& priv_key, uint64_t& nonce_prefix, uint64_t& nonce,
-                                                 const fc::microseconds& trx_expiration, const chain::chain_id_type& chain_id, const chain::block_id_type& last_irr_block_id) {
+   void trx_generator::update_transaction(chain::signed_transaction& trx, uint64_t& nonce_prefix, uint64_t& nonce,
+                                          const fc::microseconds& trx_expiration, const chain::block_id_type& last_irr_block_id) {
       trx.actions.clear();
       trx.actions = generate_actions();
-      trx_generator_base::update_resign_transaction(trx, priv_key, nonce_prefix, nonce, trx_expiration, chain_id, last_irr_block_id);
+      trx_generator_base::update_transaction(trx, nonce_prefix, nonce, trx_expiration, last_irr_block_id);
    }
 
    trx_generator::trx_generator(const trx_generator_base_config& trx_gen_base_config, const provider_base_config& provider_config, const user_specified_trx_config& usr_trx_config)
@@ -282,10 +356,12 @@ namespace eosio::testing {
            " re-sign trx, and send each updated transactions via p2p transaction provider");
 
       _provider.setup();
+      start_presigning();
       return true;
    }
 
    bool trx_generator_base::tear_down() {
+      stop_presigning();
       _provider.teardown();
       _provider.log_trxs(_config._log_dir);
 
@@ -300,7 +376,14 @@ namespace eosio::testing {
 
    bool trx_generator_base::generate_and_send() {
       try {
-         if (_trxs.size()) {
+         if (_trxs.size() && presign_enabled()) {
+            const chain::packed_transaction& ptrx = next_presigned_trx();
+            if (_txcount == 0) {
+               log_first_trx(_config._log_dir, ptrx.get_signed_transaction());
+            }
+            _provider.send(ptrx);
+            ++_txcount;
+         } else if (_trxs.size()) {
             size_t index_to_send = _txcount % _trxs.size();
             push_transaction(_trxs.at(index_to_send), ++_nonce_prefix, _nonce, _config._trx_expiration_us, _config._chain_id,
                              _config._last_irr_block_id);
@@ -5,7 +5,10 @@
 #include <eosio/chain/transaction.hpp>
 #include <eosio/chain/asset.hpp>
 #include <eosio/chain/abi_serializer.hpp>
+#include <eosio/chain/thread_utils.hpp>
 #include <fc/io/json.hpp>
+#include <deque>
+#include <future>
 
 namespace eosio::testing {
 
@@ -102,12 +105,17 @@ namespace eosio::testing {
       eosio::chain::block_id_type _last_irr_block_id = eosio::chain::block_id_type();
       std::string _log_dir = ".";
       bool _stop_on_trx_failed = true;
+      // When non-zero, transactions are updated, signed and packed ahead of time by this many worker threads
+      // and the sending thread only streams already packed transactions.
+      uint16_t _sign_threads = 0;
+      uint32_t _sign_batch_size = 1000;
 
       std::string to_string() const {
          std::ostringstream ss;
          ss << " generator id: " << _generator_id << " chain id: " << std::string(_chain_id) << " contract owner account: " 
             << _contract_owner_account << " trx expiration seconds: " << _trx_expiration_us.to_seconds() << " lib id: " << std::string(_last_irr_block_id)
-            << " log dir: " << _log_dir << " stop on trx failed: " << _stop_on_trx_failed;
+            << " log dir: " << _log_dir << " stop on trx failed: " << _stop_on_trx_failed
+            << " sign threads: " << _sign_threads << " sign batch size: " << _sign_batch_size;
          return std::move(ss).str();
       };
    };
@@ -157,10 +165,35 @@ namespace eosio::testing {
       };
    };
 
+   // A batch of transactions updated on the generator thread, then signed and packed on the signing thread pool.
+   // _signed holds one future per slice of _trxs handed to a signing thread.
+   struct presigned_trx_batch {
+      std::vector<eosio::chain::signed_transaction> _trxs;
+      std::vector<const fc::crypto::private_key*>    _signers;
+      std::vector<eosio::chain::packed_transaction>  _packed;
+      std::vector<std::future<void>>                 _signed;
+      size_t                                         _next = 0;
+
+      void wait() {
+         for (auto& f : _signed) {
+            f.get();
+         }
+         _signed.clear();
+      }
+      bool exhausted() const { return _next >= _packed.size(); }
+   };
+
    struct trx_generator_base {
+      // number of batches kept signed ahead of the sending thread
+      static constexpr size_t presign_queue_depth = 3;
+
       const trx_generator_base_config& _config;
       trx_provider _provider;
 
+      eosio::chain::named_thread_pool<struct trx_signer> _sign_thread_pool;
+      std::deque<presigned_trx_batch>                    _presigned;
+      uint64_t                                           _presign_count = 0;
+
       uint64_t _total_us = 0;
       uint64_t _txcount = 0;
 
@@ -175,9 +208,19 @@ namespace eosio::testing {
 
       virtual ~trx_generator_base() = default;
 
-      virtual void update_resign_transaction(eosio::chain::signed_transaction& trx, const fc::crypto::private_key& priv_key, uint64_t& nonce_prefix, uint64_t& nonce,
+      virtual void update_transaction(eosio::chain::signed_transaction& trx, uint64_t& nonce_prefix, uint64_t& nonce,
+                                      const fc::microseconds& trx_expiration, const eosio::chain::block_id_type& last_irr_block_id);
+
+      void update_resign_transaction(eosio::chain::signed_transaction& trx, const fc::crypto::private_key& priv_key, uint64_t& nonce_prefix, uint64_t& nonce,
                                      const fc::microseconds& trx_expiration, const eosio::chain::chain_id_type& chain_id, const eosio::chain::block_id_type& last_irr_block_id);
 
+      bool presign_enabled() const { return _config._sign_threads > 0; }
+      void start_presigning();
+      void stop_presigning();
+      presigned_trx_batch& next_presigned_batch();
+      const eosio::chain::packed_transaction& next_presigned_trx();
+      void queue_presigned_batch();
+
       void push_transaction(signed_transaction_w_signer& trx, uint64_t& nonce_prefix,
                             uint64_t& nonce, const fc::microseconds& trx_expiration, const eosio::chain::chain_id_type& chain_id,
                             const eosio::chain::block_id_type& last_irr_block_id);
@@ -229,8 +272,8 @@ namespace eosio::testing {
 
 
       std::vector<eosio::chain::action> generate_actions();
-      virtual void update_resign_transaction(eosio::chain::signed_transaction& trx, const fc::crypto::private_key& priv_key, uint64_t& nonce_prefix, uint64_t& nonce,
-                                     const fc::microseconds& trx_expiration, const eosio::chain::chain_id_type& chain_id, const eosio::chain::block_id_type& last_irr_block_id);
+      void update_transaction(eosio::chain::signed_transaction& trx, uint64_t& nonce_prefix, uint64_t& nonce,
+                              const fc::microseconds& trx_expiration, const eosio::chain::block_id_type& last_irr_block_id) override;
 
 
       bool setup();
@@ -91,6 +91,50 @@ struct mock_trx_generator {
 
 BOOST_AUTO_TEST_SUITE(trx_generator_tests)
 
+// Presigned transactions come out in the order they were generated, cycling through the templates, each signed by
+// its template's key, across several batches signed by more than one thread.
+BOOST_AUTO_TEST_CASE(presigned_trxs_in_order)
+{
+   trx_generator_base_config config;
+   config._sign_threads = 2;
+   config._sign_batch_size = 5;
+   provider_base_config provider_config;
+
+   trx_generator_base generator(config, provider_config);
+   const std::vector<fc::crypto::private_key> keys{
+      fc::crypto::private_key::regenerate<fc::ecc::private_key_shim>(fc::sha256::hash("presign key 1"s)),
+      fc::crypto::private_key::regenerate<fc::ecc::private_key_shim>(fc::sha256::hash("presign key 2"s)),
+      fc::crypto::private_key::regenerate<fc::ecc::private_key_shim>(fc::sha256::hash("presign key 3"s))};
+   for (const auto& key : keys) {
+      generator._trxs.push_back(generator.create_trx_w_actions_and_signer({}, key, generator._nonce_prefix, generator._nonce, config._trx_expiration_us,
+                                                                          config._chain_id, config._last_irr_block_id));
+   }
+
+   generator.start_presigning();
+   // more than presign_queue_depth batches, so batches are also queued while sending
+   const size_t num_trxs = config._sign_batch_size * (trx_generator_base::presign_queue_depth + 2) + 2;
+   std::set<chain::transaction_id_type> ids;
+   for (size_t i = 0; i < num_trxs; ++i) {
+      const chain::packed_transaction& ptrx = generator.next_presigned_trx();
+      const chain::signed_transaction& trx = ptrx.get_signed_transaction();
+      BOOST_TEST_INFO("trx " << i);
+
+      // context free nonce action data is "<generator id>:<nonce prefix>:<nonce>:<time>"
+      BOOST_REQUIRE_EQUAL(trx.context_free_actions.size(), 1u);
+      const auto nonce_data = fc::raw::unpack<std::string>(trx.context_free_actions[0].data);
+      const std::string expected = "0:" + std::to_string(i + 1) + ":" + std::to_string(keys.size() + i + 1) + ":";
+      BOOST_CHECK_EQUAL(nonce_data.substr(0, expected.size()), expected);
+
+      chain::flat_set<chain::public_key_type> signed_by;
+      trx.get_signature_keys(config._chain_id, fc::time_point::maximum(), signed_by);
+      BOOST_REQUIRE_EQUAL(signed_by.size(), 1u);
+      BOOST_CHECK(*signed_by.begin() == keys[i % keys.size()].get_public_key());
+
+      BOOST_CHECK(ids.insert(ptrx.id()).second);
+   }
+   generator.stop_presigning();
+}
+
 BOOST_AUTO_TEST_CASE(tps_short_run_low_tps)
 {
    constexpr uint32_t test_duration_s = 5;
@@ -148,6 +192,29 @@ BOOST_AUTO_TEST_CASE(tps_short_run_high_tps)
    }
 }
 
+// Only checks what spinning guarantees regardless of machine load: every send waits for its scheduled time.
+BOOST_AUTO_TEST_CASE(tps_spin_wait_never_sends_early)
+{
+   constexpr uint32_t test_duration_s = 1;
+   constexpr uint32_t test_tps = 1000;
+   constexpr int64_t spin_wait_us = 100;
+   constexpr uint32_t expected_trxs = test_duration_s * test_tps;
+
+   std::shared_ptr<mock_trx_generator> generator = std::make_shared<mock_trx_generator>(expected_trxs);
+   std::shared_ptr<simple_tps_monitor> monitor = std::make_shared<simple_tps_monitor>(expected_trxs);
+
+   trx_tps_tester<mock_trx_generator, simple_tps_monitor> t1(generator, monitor, {test_duration_s, test_tps, spin_wait_us});
+
+   t1.run();
+
+   BOOST_REQUIRE_EQUAL(generator->_calls.size(), expected_trxs);
+   const fc::time_point start_time = monitor->_calls.front().start_time;
+   const fc::microseconds interval = monitor->_calls.front().trx_interval;
+   for (size_t i = 1; i < generator->_calls.size(); ++i) {
+      BOOST_REQUIRE_GE((generator->_calls[i] - start_time).count(), interval.count() * static_cast<int64_t>(i));
+   }
+}
+
 BOOST_AUTO_TEST_CASE(tps_short_run_med_tps_med_delay)
 {
    constexpr uint32_t test_duration_s = 5;
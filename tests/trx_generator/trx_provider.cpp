@@ -253,6 +253,11 @@ namespace eosio::testing {
       _sent_trx_data.push_back(logged_trx_data(trx.id()));
    }
 
+   void trx_provider::send(const chain::packed_transaction& trx) {
+      _peer_connection->send_transaction(trx);
+      _sent_trx_data.push_back(logged_trx_data(trx.id()));
+   }
+
    void trx_provider::log_trxs(const std::string& log_dir) {
       std::ostringstream fileName;
       fileName << log_dir << "/trx_data_output_" << getpid() << ".txt";
@@ -131,6 +131,7 @@ namespace eosio::testing {
 
       void setup();
       void send(const chain::signed_transaction& trx);
+      void send(const chain::packed_transaction& trx);
       void log_trxs(const std::string& log_dir);
       void teardown();
 
@@ -180,10 +181,14 @@ namespace eosio::testing {
    struct trx_tps_tester_config {
       uint32_t _gen_duration_seconds;
       uint32_t _target_tps;
+      // The final stretch of each wait is spent spinning instead of sleeping, as sleep_for routinely oversleeps
+      // by tens of microseconds which is a large share of the interval at 10k+ TPS. 0 disables spinning.
+      int64_t  _spin_wait_us = 0;
 
       std::string to_string() const {
          std::ostringstream ss;
-         ss << "Trx Tps Tester Config: duration: " << _gen_duration_seconds << " target tps: " << _target_tps;
+         ss << "Trx Tps Tester Config: duration: " << _gen_duration_seconds << " target tps: " << _target_tps
+            << " spin wait us: " << _spin_wait_us;
          return ss.str();
       };
    };
@@ -240,8 +245,13 @@ namespace eosio::testing {
 
             if (keep_running) {
                fc::microseconds time_to_sleep{stats.next_run - fc::time_point::now()};
-               if (time_to_sleep.count() >= min_sleep_us) {
-                  std::this_thread::sleep_for(std::chrono::microseconds(time_to_sleep.count()));
+               if (time_to_sleep.count() - _config._spin_wait_us >= min_sleep_us) {
+                  std::this_thread::sleep_for(std::chrono::microseconds(time_to_sleep.count() - _config._spin_wait_us));
+               }
+               if (_config._spin_wait_us > 0) {
+                  while (fc::time_point::now() < stats.next_run) {
+                     std::this_thread::yield();
+                  }
                }
                stats.time_to_next_trx_us = time_to_sleep.count();
             }
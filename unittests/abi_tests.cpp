@@ -3118,6 +3118,60 @@ BOOST_AUTO_TEST_CASE(abi_deserialize_detailed_error_messages)
    } FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_CASE(abi_deserialize_compiled_plan)
+{
+   auto abi = R"({
+      "version": "eosio::abi/1.1",
+      "types": [
+         {"new_type_name": "children", "type": "node[]"},
+         {"new_type_name": "amount", "type": "uint16"}
+      ],
+      "structs": [
+         {"name": "base", "base": "", "fields": [
+            {"name": "id", "type": "amount"}
+         ]},
+         {"name": "node", "base": "base", "fields": [
+            {"name": "value", "type": "v1?"},
+            {"name": "kids", "type": "children"},
+            {"name": "tag", "type": "name$"}
+         ]}
+      ],
+      "variants": [
+         {"name": "v1", "types": ["int8", "base", "amount[]"]}
+      ],
+      "tables": [
+         {"name": "nodes", "type": "node", "index_type": "i64", "key_names": [], "key_types": []}
+      ]
+   })";
+
+   try {
+      std::optional<abi_serializer> original( std::in_place, fc::json::from_string(abi).as<abi_def>(), abi_serializer::create_yield_function( max_serialization_time ) );
+      // copies share the compiled plan, it must not refer back to the serializer it was compiled by
+      abi_serializer abis = *original;
+      original.reset();
+
+      verify_round_trip_conversion(abis, "node",
+         R"({"id":1,"value":["base",{"id":2}],"kids":[{"id":3,"value":null,"kids":[],"tag":"alice"},{"id":4,"value":["amount[]",[5,6]],"kids":[],"tag":"bob"}]})",
+         "01000101020002030000000000000000855c34040001020205000600000000000000000e3d");
+      verify_round_trip_conversion(abis, "children", R"([{"id":7,"value":["int8",-1],"kids":[],"tag":"carol"}])", "0107000100ff00000000008048af41");
+      // not a type name that appears in the ABI, decoded without the plan
+      verify_round_trip_conversion(abis, "base[]", R"([{"id":8},{"id":9}])", "0208000900");
+
+      BOOST_CHECK_EXCEPTION( abis.binary_to_variant("node", fc::variant("01000103").as<bytes>(), max_serialization_time),
+                             unpack_exception, eosio::testing::fc_exception_message_is("Unpacked invalid tag (3) for variant 'node.value'") );
+
+      // only decoding errors fall back to the type name driven path, a deadline hit while decoding with the plan
+      // is reported even though decoding again would not hit it
+      const bytes node_bin = fc::variant("01000000").as<bytes>();
+      size_t yields = 0;
+      const abi_serializer::yield_function_t deadline_once = [&yields](size_t) {
+         EOS_ASSERT( ++yields != 1, abi_serialization_deadline_exception, "deadline" );
+      };
+      fc::datastream<const char*> ds( node_bin.data(), node_bin.size() );
+      BOOST_CHECK_THROW( abis.binary_to_variant("node", ds, deadline_once), abi_serialization_deadline_exception );
+   } FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_CASE(serialize_optional_struct_type)
 {
    auto abi = R"({
@@ -3336,4 +3390,34 @@ BOOST_AUTO_TEST_CASE(abi_to_variant__add_action__no_return_value)
    }
 }
 
+// a serializer built outside the read window is not cached if its account was invalidated after the generation was taken
+BOOST_AUTO_TEST_CASE(versioned_abi_cache_generation)
+{
+   versioned_abi_cache cache;
+   const account_name account = "abi.cache"_n;
+   auto make_serializer = []() {
+      abi_def abi;
+      abi.version = "eosio::abi/1.0";
+      return std::make_shared<const abi_serializer>(std::move(abi), abi_serializer::create_yield_function(max_serialization_time));
+   };
+
+   uint64_t generation = cache.generation(account);
+   cache.insert(account, 1, make_serializer(), generation);
+   BOOST_CHECK(cache.find(account, 1));
+
+   generation = cache.generation(account);
+   cache.invalidate(account);
+   BOOST_CHECK(!cache.find(account, 1));
+   cache.insert(account, 1, make_serializer(), generation);
+   BOOST_CHECK(!cache.find(account, 1));
+
+   generation = cache.generation(account);
+   cache.clear();
+   cache.insert(account, 2, make_serializer(), generation);
+   BOOST_CHECK(!cache.find(account, 2));
+
+   cache.insert(account, 2, make_serializer(), cache.generation(account));
+   BOOST_CHECK(cache.find(account, 2));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
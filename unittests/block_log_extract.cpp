@@ -5,6 +5,8 @@
 #include <eosio/chain/block_log.hpp>
 #include <eosio/chain/block.hpp>
 #include <regex>
+#include <atomic>
+#include <thread>
 
 using namespace eosio::chain;
 
@@ -121,4 +123,36 @@ BOOST_FIXTURE_TEST_CASE(extract_to_end, block_log_extract_fixture) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(concurrent_read_while_append, block_log_extract_fixture) try {
+
+   std::atomic<bool> done = false;
+   std::atomic<uint32_t> failures = 0;
+   std::vector<std::thread> readers;
+   for (uint32_t t = 0; t < 4; ++t) {
+      readers.emplace_back([&]() {
+         while (!done) {
+            auto head = log->head();
+            for (uint32_t i = 1; i <= head->block_num(); ++i) {
+               auto b  = log->read_block_by_num(i);
+               auto bh = log->read_block_header_by_num(i);
+               if (!b || b->block_num() != i || !bh || bh->block_num() != i)
+                  ++failures;
+            }
+         }
+      });
+   }
+
+   for (uint32_t i = 13; i < 200; ++i) {
+      add(i);
+   }
+   done = true;
+   for (auto& r : readers)
+      r.join();
+
+   BOOST_REQUIRE_EQUAL(failures.load(), 0u);
+   BOOST_REQUIRE_EQUAL(log->head()->block_num(), 199u);
+   BOOST_REQUIRE_EQUAL(log->read_block_by_num(199)->block_num(), 199u);
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -322,4 +322,42 @@ BOOST_FIXTURE_TEST_CASE( abort_block_transactions_tester, validating_tester) { t
 
    } FC_LOG_AND_RETHROW() }
 
+/**
+ * Verify the shared packed block matches the block serialization and is not carried over to modified copies
+ */
+BOOST_AUTO_TEST_CASE(packed_block_cache_test) { try {
+   tester main;
+   main.create_account("newacc"_n);
+   auto b = main.produce_block();
+
+   auto packed = b->packed_block();
+   BOOST_REQUIRE( packed );
+   BOOST_TEST( *packed == fc::raw::pack(*b) );
+   BOOST_TEST( b->packed_block() == packed ); // packed only once
+
+   // a block unpacked from bytes can share them
+   auto unpacked = std::make_shared<signed_block>();
+   fc::raw::unpack( *packed, *unpacked );
+   unpacked->set_packed_block( packed );
+   BOOST_TEST( unpacked->packed_block() == packed );
+
+   // a modified copy is packed again
+   auto copy_b = std::make_shared<signed_block>( b->clone() );
+   copy_b->block_extensions.emplace_back();
+   BOOST_TEST( *copy_b->packed_block() == fc::raw::pack(*copy_b) );
+   BOOST_TEST( *copy_b->packed_block() != *packed );
+
+   // assigning over a block drops its cache
+   *copy_b = b->clone();
+   BOOST_TEST( *copy_b->packed_block() == *packed );
+   BOOST_TEST( copy_b->packed_block() != packed );
+
+   // released bytes are packed again on the next use
+   b->release_packed_block();
+   auto repacked = b->packed_block();
+   BOOST_TEST( repacked != packed );
+   BOOST_TEST( *repacked == *packed );
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
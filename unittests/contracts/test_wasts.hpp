@@ -776,6 +776,88 @@ static const char memory_growth_memset_test[] = R"=====(
 )
 )=====";
 
+static const char memory_dirty_trap_wast[] = R"=====(
+(module
+ (export "apply" (func $apply))
+ (memory $0 2)
+ (func $apply (param $0 i64)(param $1 i64)(param $2 i64)
+    (drop (grow_memory (i32.const 1)))
+    (i32.store (i32.const 0) (i32.const 1))
+    (i32.store (i32.const 80000) (i32.const 2))
+    (i32.store (i32.const 140000) (i32.const 3))
+    (unreachable)
+ )
+)
+)=====";
+
+static const char memory_dirty_loop_wast[] = R"=====(
+(module
+ (export "apply" (func $apply))
+ (memory $0 2)
+ (func $apply (param $0 i64)(param $1 i64)(param $2 i64)
+    (drop (grow_memory (i32.const 1)))
+    (i32.store (i32.const 0) (i32.const 1))
+    (i32.store (i32.const 80000) (i32.const 2))
+    (i32.store (i32.const 140000) (i32.const 3))
+    (loop (br 0))
+ )
+)
+)=====";
+
+static const char memory_zero_check_wast[] = R"=====(
+(module
+ (export "apply" (func $apply))
+ (import "env" "eosio_assert" (func $eosio_assert (param i32 i32)))
+ (memory $0 2)
+ (func $apply (param $0 i64)(param $1 i64)(param $2 i64)
+   (call $eosio_assert (i32.eqz (i32.load (i32.const 0))) (i32.const 0))
+   (call $eosio_assert (i32.eqz (i32.load (i32.const 80000))) (i32.const 0))
+   (drop (grow_memory (i32.const 1)))
+   (call $eosio_assert (i32.eqz (i32.load (i32.const 140000))) (i32.const 0))
+ )
+)
+)=====";
+
+// runs the ops in its action data in order against row 1 of table 1 in its own scope:
+//   0 store the row, creating the table; 1 remove the row, removing the table; 2 assert the row is found;
+//   3 assert the table does not exist; 4 fail the action
+static const char table_ops_wast[] = R"=====(
+(module
+ (import "env" "read_action_data" (func $read_action_data (param i32 i32) (result i32)))
+ (import "env" "db_store_i64" (func $db_store_i64 (param i64 i64 i64 i64 i32 i32) (result i32)))
+ (import "env" "db_find_i64" (func $db_find_i64 (param i64 i64 i64 i64) (result i32)))
+ (import "env" "db_remove_i64" (func $db_remove_i64 (param i32)))
+ (import "env" "eosio_assert" (func $eosio_assert (param i32 i32)))
+ (memory $0 1)
+ (export "apply" (func $apply))
+ (func $apply (param $receiver i64) (param $account i64) (param $action_name i64)
+  (local $len i32) (local $i i32) (local $op i32) (local $itr i32)
+  (set_local $len (call $read_action_data (i32.const 16) (i32.const 1024)))
+  (block $done
+   (loop $next
+    (br_if $done (i32.ge_u (get_local $i) (get_local $len)))
+    (set_local $op (i32.load8_u offset=16 (get_local $i)))
+    (set_local $itr (call $db_find_i64 (get_local $receiver) (get_local $receiver) (i64.const 1) (i64.const 1)))
+    (if (i32.eq (get_local $op) (i32.const 0))
+     (then (drop (call $db_store_i64 (get_local $receiver) (i64.const 1) (get_local $receiver) (i64.const 1) (i32.const 0) (i32.const 8)))))
+    (if (i32.eq (get_local $op) (i32.const 1))
+     (then
+      (call $eosio_assert (i32.ge_s (get_local $itr) (i32.const 0)) (i32.const 0))
+      (call $db_remove_i64 (get_local $itr))))
+    (if (i32.eq (get_local $op) (i32.const 2))
+     (then (call $eosio_assert (i32.ge_s (get_local $itr) (i32.const 0)) (i32.const 0))))
+    (if (i32.eq (get_local $op) (i32.const 3))
+     (then (call $eosio_assert (i32.eq (get_local $itr) (i32.const -1)) (i32.const 0))))
+    (if (i32.eq (get_local $op) (i32.const 4))
+     (then (call $eosio_assert (i32.const 0) (i32.const 0))))
+    (set_local $i (i32.add (get_local $i) (i32.const 1)))
+    (br $next)
+   )
+  )
+ )
+)
+)=====";
+
 static const char large_maligned_host_ptr[] = R"=====(
 (module
  (export "apply" (func $$apply))
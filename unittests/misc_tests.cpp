@@ -881,6 +881,32 @@ BOOST_AUTO_TEST_CASE(signed_int_test) { try {
 
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE(packed_transaction_non_canonical_id_test) { try {
+   testing::tester test;
+   signed_transaction trx;
+   trx.actions.emplace_back( vector<permission_level>{{config::system_account_name, config::active_name}},
+                             config::system_account_name, "reqauth"_n, fc::raw::pack(config::system_account_name) );
+   test.set_transaction_headers(trx);
+   trx.max_net_usage_words = 1u << 28; // packs as a 5 byte varint
+   trx.sign( test.get_private_key( config::system_account_name, "active" ), test.control->get_chain_id() );
+   packed_transaction pkt(trx, packed_transaction::compression_type::none);
+
+   // same sized encoding of the same transaction: the 5th varint byte has bits beyond 32 set which unpack drops
+   bytes non_canonical = pkt.get_packed_transaction();
+   const size_t max_net_usage_words_last_byte = 4 + 2 + 4 + 4; // expiration, ref_block_num, ref_block_prefix, 4 varint bytes
+   BOOST_REQUIRE_EQUAL( non_canonical[max_net_usage_words_last_byte], 0x01 );
+   non_canonical[max_net_usage_words_last_byte] = 0x11;
+   BOOST_REQUIRE_EQUAL( non_canonical.size(), pkt.get_packed_transaction().size() );
+   BOOST_REQUIRE_NE( trx.id(), fc::sha256::hash( non_canonical.data(), non_canonical.size() ) );
+
+   // the id is always the id of the unpacked transaction, never the hash of the bytes received
+   bytes serialized_non_canonical = fc::raw::pack( std::make_tuple( trx.signatures, uint8_t(0), bytes(), non_canonical ) );
+   packed_transaction unpacked_non_canonical;
+   fc::raw::unpack( serialized_non_canonical, unpacked_non_canonical );
+   BOOST_CHECK_EQUAL( trx.max_net_usage_words.value, unpacked_non_canonical.get_transaction().max_net_usage_words.value );
+   BOOST_CHECK_EQUAL( trx.id(), unpacked_non_canonical.id() );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_CASE(transaction_metadata_test) { try {
 
    testing::validating_tester test;
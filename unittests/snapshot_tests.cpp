@@ -687,4 +687,99 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(jumbo_row, SNAPSHOT_SUITE, snapshot_suites)
    snapshotted_tester sst(chain.get_config(), SNAPSHOT_SUITE::get_reader(snapshot), 0);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_snapshot_matches_serial)
+{
+   // an ostream writer that forces controller to walk and write every section on the calling thread
+   struct serial_ostream_snapshot_writer : ostream_snapshot_writer {
+      using ostream_snapshot_writer::ostream_snapshot_writer;
+      bool supports_buffered_sections() const override { return false; }
+   };
+
+   fc::temp_directory tempdir;
+   auto config = tester::default_config(tempdir);
+   // split the contract_tables section into many parts
+   config.first.snapshot_contract_tables_part_rows = 2;
+   tester chain(config.first, config.second);
+   BOOST_REQUIRE_GT(chain.get_config().thread_pool_size, 1);
+
+   const std::vector<account_name> accounts = {"snapshot"_n, "snapshot1"_n, "snapshot2"_n, "snapshot3"_n};
+   chain.create_accounts(accounts);
+   chain.produce_blocks(1);
+   for (const auto& account : accounts) {
+      chain.set_code(account, test_contracts::snapshot_test_wasm());
+      chain.set_abi(account, test_contracts::snapshot_test_abi());
+   }
+   chain.produce_blocks(1);
+   for (const auto& account : accounts) {
+      chain.push_action(account, "increment"_n, account, mutable_variant_object()("value", 1));
+   }
+   chain.produce_blocks(1);
+   chain.control->abort_block();
+
+   std::ostringstream parallel_out;
+   auto parallel_writer = std::make_shared<ostream_snapshot_writer>(parallel_out);
+   BOOST_REQUIRE(parallel_writer->supports_buffered_sections());
+   chain.control->write_snapshot(parallel_writer);
+   parallel_writer->finalize();
+
+   std::ostringstream serial_out;
+   auto serial_writer = std::make_shared<serial_ostream_snapshot_writer>(serial_out);
+   chain.control->write_snapshot(serial_writer);
+   serial_writer->finalize();
+
+   std::istringstream parallel_in(parallel_out.str());
+   BOOST_REQUIRE_GT(istream_snapshot_reader(parallel_in).section_chunks("contract_tables").size(), 1u);
+
+   // same sections, the parallel snapshot is followed by the directory of the contract_tables parts
+   const auto end_marker_size = sizeof(uint64_t);
+   const std::string serial_sections = serial_out.str().substr(0, serial_out.str().size() - end_marker_size);
+   BOOST_REQUIRE(parallel_out.str().compare(0, serial_sections.size(), serial_sections) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_snapshot_load)
+{
+   fc::temp_directory tempdir;
+   auto config = tester::default_config(tempdir);
+   // split the contract_tables section into many parts so it is loaded concurrently
+   config.first.snapshot_contract_tables_part_rows = 2;
+   tester chain(config.first, config.second);
+   BOOST_REQUIRE_GT(chain.get_config().thread_pool_size, 1);
+
+   const std::vector<account_name> accounts = {"snapshot"_n, "snapshot1"_n, "snapshot2"_n, "snapshot3"_n};
+   chain.create_accounts(accounts);
+   chain.produce_blocks(1);
+   for (const auto& account : accounts) {
+      chain.set_code(account, test_contracts::snapshot_test_wasm());
+      chain.set_abi(account, test_contracts::snapshot_test_abi());
+   }
+   chain.produce_blocks(1);
+   for (const auto& account : accounts) {
+      chain.push_action(account, "increment"_n, account, mutable_variant_object()("value", 1));
+   }
+   chain.produce_blocks(1);
+   chain.control->abort_block();
+
+   auto writer = buffered_snapshot_suite::get_writer();
+   chain.control->write_snapshot(writer);
+   auto snapshot = buffered_snapshot_suite::finalize(writer);
+
+   auto chunks = buffered_snapshot_suite::get_reader(snapshot)->section_chunks("contract_tables");
+   BOOST_REQUIRE_GT(chunks.size(), 1u);
+
+   // concurrent load from the chunks
+   snapshotted_tester parallel(chain.get_config(), buffered_snapshot_suite::get_reader(snapshot), 0);
+   verify_integrity_hash<buffered_snapshot_suite>(*chain.control, *parallel.control);
+
+   // sequential load of the same snapshot ignores the directory
+   auto serial_config = chain.get_config();
+   serial_config.thread_pool_size = 1;
+   snapshotted_tester serial(serial_config, buffered_snapshot_suite::get_reader(snapshot), 1);
+   verify_integrity_hash<buffered_snapshot_suite>(*chain.control, *serial.control);
+
+   // the snapshot, directory included, does not depend on the size of the thread pool
+   auto serial_writer = buffered_snapshot_suite::get_writer();
+   serial.control->write_snapshot(serial_writer);
+   BOOST_REQUIRE(buffered_snapshot_suite::finalize(serial_writer) == snapshot);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
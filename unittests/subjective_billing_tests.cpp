@@ -127,6 +127,107 @@ BOOST_AUTO_TEST_CASE( subjective_bill_test ) {
 
 }
 
+BOOST_AUTO_TEST_CASE( subjective_bill_expiry_wheel_test ) {
+
+   fc::logger log;
+
+   transaction_id_type id1 = sha256::hash( "1" );
+   transaction_id_type id2 = sha256::hash( "2" );
+   transaction_id_type id3 = sha256::hash( "3" );
+   transaction_id_type id4 = sha256::hash( "4" );
+   account_name a = "a"_n;
+   account_name b = "b"_n;
+
+   const fc::time_point_sec now_sec{time_point::now()};
+   const time_point now = now_sec.to_time_point();
+
+   subjective_billing sub_bill;
+   sub_bill.subjective_bill( id1, now_sec + 10, a, fc::microseconds( 13 ) );
+   sub_bill.subjective_bill( id2, now_sec + 2, a, fc::microseconds( 11 ) );
+   sub_bill.subjective_bill( id3, now_sec + 10, b, fc::microseconds( 9 ) );
+   sub_bill.subjective_bill( id4, now_sec, b, fc::microseconds( 7 ) ); // earlier than anything already billed
+   sub_bill.subjective_bill( id4, now_sec, b, fc::microseconds( 7 ) ); // duplicate ignored
+   BOOST_CHECK_EQUAL( 4u, sub_bill.get_trx_cache_size() );
+   BOOST_CHECK_EQUAL( 13+11, sub_bill.get_subjective_bill(a, now) );
+   BOOST_CHECK_EQUAL( 9+7, sub_bill.get_subjective_bill(b, now) );
+
+   // nothing expires before its expiration, block times are second granularity
+   BOOST_CHECK( sub_bill.remove_expired( log, now - fc::microseconds(1), now, [](){ return false; } ) );
+   BOOST_CHECK_EQUAL( 4u, sub_bill.get_trx_cache_size() );
+
+   // id4 expires exactly at its expiration, the expired bill decays instead of disappearing
+   BOOST_CHECK( sub_bill.remove_expired( log, now, now, [](){ return false; } ) );
+   BOOST_CHECK_EQUAL( 3u, sub_bill.get_trx_cache_size() );
+   BOOST_CHECK_EQUAL( 9+7, sub_bill.get_subjective_bill(b, now) );
+
+   // id2 applied in a block before it expires
+   sub_bill.remove_subjective_billing( id2, 0 );
+   BOOST_CHECK_EQUAL( 13, sub_bill.get_subjective_bill(a, now) );
+   BOOST_CHECK( sub_bill.remove_expired( log, now + fc::seconds(5), now, [](){ return false; } ) );
+   BOOST_CHECK_EQUAL( 2u, sub_bill.get_trx_cache_size() );
+
+   // interrupted expiration picks up where it left off
+   BOOST_CHECK( !sub_bill.remove_expired( log, now + fc::seconds(10), now, [](){ return true; } ) );
+   BOOST_CHECK_EQUAL( 2u, sub_bill.get_trx_cache_size() );
+   uint32_t calls = 0;
+   BOOST_CHECK( !sub_bill.remove_expired( log, now + fc::seconds(10), now, [&](){ return ++calls > 1; } ) );
+   BOOST_CHECK_EQUAL( 1u, sub_bill.get_trx_cache_size() );
+   BOOST_CHECK( sub_bill.remove_expired( log, now + fc::seconds(10), now, [](){ return false; } ) );
+   BOOST_CHECK_EQUAL( 0u, sub_bill.get_trx_cache_size() );
+   BOOST_CHECK_EQUAL( 13, sub_bill.get_subjective_bill(a, now) );
+   BOOST_CHECK_EQUAL( 9+7, sub_bill.get_subjective_bill(b, now) );
+
+   // billing again after the wheel emptied
+   sub_bill.subjective_bill( id1, now_sec + 20, a, fc::microseconds( 5 ) );
+   BOOST_CHECK_EQUAL( 13+5, sub_bill.get_subjective_bill(a, now) );
+   BOOST_CHECK( sub_bill.remove_expired( log, now + fc::seconds(19), now, [](){ return false; } ) );
+   BOOST_CHECK_EQUAL( 1u, sub_bill.get_trx_cache_size() );
+   BOOST_CHECK( sub_bill.remove_expired( log, now + fc::seconds(20), now, [](){ return false; } ) );
+   BOOST_CHECK_EQUAL( 0u, sub_bill.get_trx_cache_size() );
+}
+
+BOOST_AUTO_TEST_CASE( subjective_bill_expiry_wheel_on_block_test ) {
+
+   fc::logger log;
+   account_name a = "a"_n;
+
+   const fc::time_point_sec now_sec{time_point::now()};
+   const time_point now = now_sec.to_time_point();
+
+   subjective_billing sub_bill;
+   auto block = std::make_shared<signed_block>();
+   for( uint32_t i = 0; i < 12; ++i ) {
+      signed_transaction trx;
+      trx.expiration = now_sec + 60 + i % 3; // several ids per bucket
+      trx.ref_block_num = i;
+      packed_transaction pt( trx );
+      sub_bill.subjective_bill( pt.id(), trx.expiration, a, fc::microseconds( 1 ) );
+      if( i % 2 == 0 ) // every other trx, from the middle and the end of the buckets
+         block->transactions.emplace_back( pt );
+   }
+   BOOST_CHECK_EQUAL( 12u, sub_bill.get_trx_cache_size() );
+   BOOST_CHECK_EQUAL( 12u, sub_bill.get_expiry_wheel_size() );
+
+   // trxs included in a block leave the wheel right away, not at their expiration
+   sub_bill.on_block( log, block, now );
+   BOOST_CHECK_EQUAL( 6u, sub_bill.get_trx_cache_size() );
+   BOOST_CHECK_EQUAL( 6u, sub_bill.get_expiry_wheel_size() );
+   BOOST_CHECK_EQUAL( 6, sub_bill.get_subjective_bill(a, now) );
+
+   // a block with the same trxs again changes nothing
+   sub_bill.on_block( log, block, now );
+   BOOST_CHECK_EQUAL( 6u, sub_bill.get_expiry_wheel_size() );
+
+   // the remaining trxs still expire from their buckets
+   BOOST_CHECK( sub_bill.remove_expired( log, now + fc::seconds(61), now, [](){ return false; } ) );
+   BOOST_CHECK_EQUAL( 2u, sub_bill.get_trx_cache_size() );
+   BOOST_CHECK_EQUAL( 2u, sub_bill.get_expiry_wheel_size() );
+   BOOST_CHECK( sub_bill.remove_expired( log, now + fc::seconds(62), now, [](){ return false; } ) );
+   BOOST_CHECK_EQUAL( 0u, sub_bill.get_trx_cache_size() );
+   BOOST_CHECK_EQUAL( 0u, sub_bill.get_expiry_wheel_size() );
+   BOOST_CHECK_EQUAL( 6, sub_bill.get_subjective_bill(a, now) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
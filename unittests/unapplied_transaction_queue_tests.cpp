@@ -413,4 +413,66 @@ BOOST_AUTO_TEST_CASE( unapplied_transaction_queue_incoming_count ) try {
 
 } FC_LOG_AND_RETHROW() /// unapplied_transaction_queue_incoming_count
 
+BOOST_AUTO_TEST_CASE( unapplied_transaction_queue_recent_trxs ) try {
+
+   unapplied_transaction_queue q;
+
+   auto priv_key = eosio::testing::base_tester::get_private_key( config::system_account_name, "active" );
+   auto recovered_trx_meta_data = [&]() {
+      static uint64_t nextid = 0;
+      ++nextid;
+      signed_transaction trx;
+      trx.expiration = fc::time_point_sec{fc::time_point::now() + fc::seconds( 120 )};
+      trx.actions.emplace_back( vector<permission_level>{{config::system_account_name,config::active_name}},
+                                onerror{ nextid, "recent", 6 });
+      trx.sign( priv_key, chain_id_type::empty_chain_id() );
+      return transaction_metadata::recover_keys( std::make_shared<packed_transaction>( std::move(trx) ), chain_id_type::empty_chain_id(),
+                                                 fc::microseconds::maximum(), transaction_metadata::trx_type::input );
+   };
+
+   auto trx1 = recovered_trx_meta_data();
+   auto trx2 = recovered_trx_meta_data();
+   auto trx3 = recovered_trx_meta_data();
+   auto no_keys_trx = unique_trx_meta_data();
+
+   // the test trxs are all the same size, room for two of them
+   unapplied_transaction_queue sizing;
+   sizing.add_aborted( { trx1 } );
+   const uint64_t trx_size = sizing.recent_trxs_bytes();
+   BOOST_REQUIRE( trx_size > 0u );
+   q.set_max_recent_trxs_size( 2 * trx_size );
+
+   q.add_aborted( { trx1, trx2, no_keys_trx } );
+   BOOST_CHECK_EQUAL( q.recent_trxs_size(), 2u ); // only trxs with recovered keys are kept
+   BOOST_CHECK_EQUAL( q.recent_trxs_bytes(), 2 * trx_size );
+   while( next( q ) ) {}
+   BOOST_CHECK( q.empty() );
+
+   // no longer in the queue, but still found for push_block
+   BOOST_CHECK( q.get_trx( trx1->id() ) == nullptr );
+   BOOST_CHECK( q.find_trx_meta( trx1->id() ) == trx1 );
+   BOOST_CHECK( q.find_trx_meta( trx2->id() ) == trx2 );
+   BOOST_CHECK( q.find_trx_meta( no_keys_trx->id() ) == nullptr );
+
+   // trx2 is least recently used after the lookups above and is evicted
+   BOOST_CHECK( q.find_trx_meta( trx1->id() ) == trx1 );
+   auto bs1 = create_test_block_state( { trx3 } );
+   q.add_forked( { bs1 } );
+   BOOST_CHECK_EQUAL( q.recent_trxs_size(), 2u );
+   BOOST_CHECK_EQUAL( q.recent_trxs_bytes(), 2 * trx_size );
+   BOOST_CHECK( q.find_trx_meta( trx2->id() ) == nullptr );
+   BOOST_CHECK( q.find_trx_meta( trx1->id() ) == trx1 );
+   BOOST_CHECK( q.find_trx_meta( trx3->id() ) == trx3 );
+
+   q.set_max_recent_trxs_size( trx_size );
+   BOOST_CHECK_EQUAL( q.recent_trxs_size(), 1u );
+   BOOST_CHECK( q.find_trx_meta( trx1->id() ) == nullptr ); // trx3 is more recently used
+
+   q.set_max_recent_trxs_size( 0 );
+   BOOST_CHECK_EQUAL( q.recent_trxs_size(), 0u );
+   BOOST_CHECK_EQUAL( q.recent_trxs_bytes(), 0u );
+   BOOST_CHECK( q.find_trx_meta( trx3->id() ) == trx3 ); // still in the queue
+
+} FC_LOG_AND_RETHROW() /// unapplied_transaction_queue_recent_trxs
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1473,6 +1473,103 @@ BOOST_FIXTURE_TEST_CASE( mem_growth_memset, validating_tester ) try {
    }
 } FC_LOG_AND_RETHROW()
 
+// linear memory written by an action must read back as zero in the next execution, even when the
+// writing action trapped or ran out of time
+BOOST_FIXTURE_TEST_CASE( mem_reset_after_failure, validating_tester ) try {
+   produce_blocks(2);
+
+   create_accounts( {"dirtytrap"_n, "dirtyloop"_n, "zerocheck"_n} );
+   produce_block();
+
+   set_code("dirtytrap"_n, memory_dirty_trap_wast);
+   set_code("dirtyloop"_n, memory_dirty_loop_wast);
+   set_code("zerocheck"_n, memory_zero_check_wast);
+   produce_blocks(1);
+
+   uint32_t expiration = DEFAULT_EXPIRATION_DELTA;
+   auto make_trx = [&](name account, uint8_t max_cpu_usage_ms = 0) {
+      signed_transaction trx;
+      action act;
+      act.account = account;
+      act.name = ""_n;
+      act.authorization = vector<permission_level>{{account,config::active_name}};
+      trx.actions.push_back(act);
+      set_transaction_headers(trx, ++expiration); // expiration keeps the zerocheck trxs of a block unique
+      trx.max_cpu_usage_ms = max_cpu_usage_ms;
+      trx.sign(get_private_key( account, "active" ), control->get_chain_id());
+      return trx;
+   };
+   auto check_zero = [&]() {
+      auto trx = make_trx("zerocheck"_n);
+      push_transaction(trx);
+   };
+
+   check_zero();
+   for (int i = 0; i < 3; ++i) {
+      auto trap_trx = make_trx("dirtytrap"_n);
+      BOOST_CHECK_THROW(push_transaction(trap_trx), wasm_execution_error);
+      check_zero();
+
+      auto loop_trx = make_trx("dirtyloop"_n, 5);
+      // not explicitly billed so the loop is stopped by the trx max_cpu_usage_ms
+      BOOST_CHECK_THROW(push_transaction(loop_trx, fc::time_point::maximum(), 0), tx_cpu_usage_exceeded);
+      check_zero();
+      produce_block();
+   }
+} FC_LOG_AND_RETHROW()
+
+// tables found, created and removed by a transaction are memoized by its transaction_context; lookups after a table
+// is removed and created again, within one action and across actions, must agree with chainbase
+BOOST_FIXTURE_TEST_CASE( table_memo_create_remove, validating_tester ) try {
+   produce_blocks(2);
+
+   create_accounts( {"tableops"_n} );
+   produce_block();
+
+   set_code("tableops"_n, table_ops_wast);
+   produce_blocks(1);
+
+   enum op : char { store = 0, remove = 1, found = 2, no_table = 3, fail = 4 };
+   uint32_t expiration = DEFAULT_EXPIRATION_DELTA;
+   // each element of actions is the op sequence run by one action
+   auto push_ops = [&](const std::vector<std::vector<char>>& actions) {
+      signed_transaction trx;
+      for( const auto& ops : actions ) {
+         action act;
+         act.account = "tableops"_n;
+         act.name = ""_n;
+         act.authorization = vector<permission_level>{{"tableops"_n,config::active_name}};
+         act.data = ops;
+         trx.actions.push_back(act);
+      }
+      set_transaction_headers(trx, ++expiration);
+      trx.sign(get_private_key( "tableops"_n, "active" ), control->get_chain_id());
+      push_transaction(trx);
+   };
+   auto table_exists = [&]() {
+      return control->db().find<table_id_object, by_code_scope_table>(
+         boost::make_tuple("tableops"_n, "tableops"_n, name(1))) != nullptr;
+   };
+
+   // within one action: a miss is memoized, then the table is created, removed and created again
+   push_ops({ {no_table, store, found, remove, no_table, store, found} });
+   BOOST_CHECK( table_exists() );
+
+   // across the actions of one transaction
+   push_ops({ {found}, {remove}, {no_table}, {store}, {found}, {remove}, {no_table} });
+   BOOST_CHECK( !table_exists() );
+
+   // a failed transaction undoes the table it created
+   BOOST_CHECK_THROW( push_ops({ {no_table, store}, {found}, {fail} }), eosio_assert_message_exception );
+   BOOST_CHECK( !table_exists() );
+   push_ops({ {no_table}, {store, found} });
+   BOOST_CHECK( table_exists() );
+
+   produce_block();
+   push_ops({ {found, remove, no_table} });
+   BOOST_CHECK( !table_exists() );
+} FC_LOG_AND_RETHROW()
+
 INCBIN(fuzz1, "fuzz1.wasm");
 INCBIN(fuzz2, "fuzz2.wasm");
 INCBIN(fuzz3, "fuzz3.wasm");